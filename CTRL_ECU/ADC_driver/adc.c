@@ -0,0 +1,141 @@
+/******************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: adc.c
+ *
+ * Description: Source file for the ADC AVR driver
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "adc.h"
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static void (*volatile g_ADC_callBackPtr)(uint16) = NULL_PTR;
+
+/*------------------------------------------------------------------------------
+ *                       Interrupt Service Routines                            *
+-------------------------------------------------------------------------------*/
+/*
+ * ADC Conversion Complete
+ */
+ISR(ADC_vect)
+{
+	if(g_ADC_callBackPtr != NULL_PTR)
+	{
+		(*g_ADC_callBackPtr)(ADC);
+	}
+}
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_init
+ *
+ * [Description]:  Function responsible for initialize the ADC driver: reference voltage,
+ * 					clock and enable, no conversion is started
+ *
+ * [Args]:        Config_Ptr: a constant pointer to struct that defines the ADC required configuration
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_init(const ADC_ConfigType * Config_Ptr)
+{
+	/************************** ADMUX Description **************************
+	 * REFS1:0 = reference voltage of the configuration
+	 * ADLAR   = 0 right adjusted result
+	 * MUX4:0  = 00000 channel 0 at the beginning
+	 ***********************************************************************/
+	ADMUX = ((Config_Ptr->ref_volt) & 0x03) << REFS0;
+
+	/************************** ADCSRA Description **************************
+	 * ADEN    = 1 Enable ADC
+	 * ADIE    = 0 Disable ADC Interrupt until the free running mode starts
+	 * ADATE   = 0 Disable Auto Trigger
+	 * ADPS2:0 = ADC clock prescaler of the configuration
+	 ***********************************************************************/
+	ADCSRA = (1<<ADEN) | ((Config_Ptr->prescaler) & 0x07);
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_readChannel
+ *
+ * [Description]:  Function responsible for one conversion of a channel, waits (polling) for the result.
+ * 					Not to be used while the free running mode is on.
+ *
+ * [Args]:        channel_num: channel 0-7
+ *
+ * [Returns]:      the 10 bits result
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 ADC_readChannel(uint8 channel_num)
+{
+	/* Choose the channel in the first 3 bits of ADMUX */
+	ADMUX = (ADMUX & 0xE0) | (channel_num & 0x07);
+	/* Start conversion */
+	SET_BIT(ADCSRA,ADSC);
+	/* Wait for the conversion to complete, ADIF becomes '1' */
+	while(BIT_IS_CLEAR(ADCSRA,ADIF));
+	/* Clear ADIF by write '1' to it */
+	SET_BIT(ADCSRA,ADIF);
+	return ADC;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_startFreeRunning
+ *
+ * [Description]:  Function responsible for converting a channel continuously, the call back
+ * 					function gets every result from the ADC conversion complete interrupt
+ *
+ * [Args]:        channel_num: channel 0-7
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_startFreeRunning(uint8 channel_num)
+{
+	ADMUX = (ADMUX & 0xE0) | (channel_num & 0x07);
+
+	/* ADTS2:0 = 000 Free Running mode as the auto trigger source */
+	SFIOR &= ~((1<<ADTS2) | (1<<ADTS1) | (1<<ADTS0));
+
+	/* ADIF is cleared by writing '1', then auto trigger, interrupt and the first conversion */
+	ADCSRA |= (1<<ADIF) | (1<<ADATE) | (1<<ADIE) | (1<<ADSC);
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_stopFreeRunning
+ *
+ * [Description]:  Function responsible for stopping the conversions started by ADC_startFreeRunning
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_stopFreeRunning(void)
+{
+	ADCSRA &= ~((1<<ADATE) | (1<<ADIE));
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_setCallBack
+ *
+ * [Description]:  Function to set the Call Back function address.
+ *
+ * [Args]:        a_ptr: a pointer to a void function that takes the conversion result
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_setCallBack(void(*a_ptr)(uint16))
+{
+	/* Save the address of the Call back function in a global variable */
+	g_ADC_callBackPtr = a_ptr;
+}
@@ -0,0 +1,124 @@
+/******************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: adc.h
+ *
+ * Description: Header file for the ADC AVR driver
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+#include "std_types.h"
+#include "common_macros.h"
+#include <avr/interrupt.h>
+#include "avr/io.h" /* To use the ADC Registers */
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+#define ADC_MAXIMUM_VALUE			1023
+#define ADC_NUM_OF_CHANNELS			8
+
+/*-----------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum
+{
+	ADC_AREF,ADC_AVCC,ADC_INTERNAL_2_56V=3
+}ADC_ReferenceVoltage;
+
+/* one conversion takes 13 ADC clocks (25 for the first one) */
+typedef enum
+{
+	ADC_F_CPU_2=1,ADC_F_CPU_4,ADC_F_CPU_8,ADC_F_CPU_16,ADC_F_CPU_32,ADC_F_CPU_64,ADC_F_CPU_128
+}ADC_Prescaler;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: ADC_ConfigType
+ *
+ * [Description]: This structure is responsible for maintaining information about the ADC configuration
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * ref_volt: a struct member of type ADC_ReferenceVoltage to select the reference of the conversion
+	 */
+			ADC_ReferenceVoltage	ref_volt;
+	/*
+	 * prescaler: a struct member of type ADC_Prescaler to select the ADC clock (50-200 kHz for 10 bits)
+	 */
+			ADC_Prescaler			prescaler;
+}ADC_ConfigType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                           		 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_init
+ *
+ * [Description]:  Function responsible for initialize the ADC driver: reference voltage,
+ * 					clock and enable, no conversion is started
+ *
+ * [Args]:        Config_Ptr: a constant pointer to struct that defines the ADC required configuration
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_init(const ADC_ConfigType * Config_Ptr);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_readChannel
+ *
+ * [Description]:  Function responsible for one conversion of a channel, waits (polling) for the result.
+ * 					Not to be used while the free running mode is on.
+ *
+ * [Args]:        channel_num: channel 0-7
+ *
+ * [Returns]:      the 10 bits result
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 ADC_readChannel(uint8 channel_num);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_startFreeRunning
+ *
+ * [Description]:  Function responsible for converting a channel continuously, the call back
+ * 					function gets every result from the ADC conversion complete interrupt
+ *
+ * [Args]:        channel_num: channel 0-7
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_startFreeRunning(uint8 channel_num);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_stopFreeRunning
+ *
+ * [Description]:  Function responsible for stopping the conversions started by ADC_startFreeRunning
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_stopFreeRunning(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: ADC_setCallBack
+ *
+ * [Description]:  Function to set the Call Back function address.
+ *
+ * [Args]:        a_ptr: a pointer to a void function that takes the conversion result
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void ADC_setCallBack(void(*a_ptr)(uint16));
+
+#endif /* ADC_H_ */
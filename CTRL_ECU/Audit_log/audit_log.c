@@ -0,0 +1,233 @@
+/******************************************************************************
+ *
+ * Module: Audit log
+ *
+ * File Name: audit_log.c
+ *
+ * Description: Source file for the append-only access audit log ring kept in the external EEPROM
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "audit_log.h"
+#include "crc16.h"
+#include "uart.h"
+
+#if ((AUDIT_START_ADDRESS % EEPROM_PAGE_SIZE) != 0) || ((AUDIT_SIZE % EEPROM_PAGE_SIZE) != 0)
+#error "The audit log ring must be made of whole EEPROM pages"
+#endif
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+#define AUDIT_RECORD_ADDRESS(index)		(AUDIT_START_ADDRESS + ((uint16)(index) * AUDIT_RECORD_SIZE))
+#define AUDIT_CRC_COVERED_BYTES			(AUDIT_RECORD_SIZE - sizeof(uint8))
+
+/* compile time check: the record layout must match AUDIT_RECORD_SIZE */
+typedef char AUDIT_RecordSizeCheck[(sizeof(AUDIT_RecordType) == AUDIT_RECORD_SIZE) ? 1 : -1];
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+/* image of the head page: g_pageCount records of it are known, g_flushedCount are in the EEPROM */
+static AUDIT_RecordType g_page[AUDIT_RECORDS_PER_PAGE];
+static uint8 g_pageCount = 0;
+static uint8 g_flushedCount = 0;
+/* index of the first record of the head page */
+static uint8 g_pageBase = 0;
+/* number of records in the ring and the sequence number of the next record */
+static uint8 g_count = 0;
+static uint8 g_sequence = 0;
+
+/*------------------------------------------------------------------------------
+ *                      Functions Prototypes(Private)                          *
+-------------------------------------------------------------------------------*/
+static boolean AUDIT_isValid(const AUDIT_RecordType *record);
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+static boolean AUDIT_isValid(const AUDIT_RecordType *record)
+{
+	return (record->event < AUDIT_NUM_OF_EVENTS) &&
+		   (record->crc == CRC8_update(CRC8_INITIAL_VALUE, (const uint8 *)record, AUDIT_CRC_COVERED_BYTES));
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_init
+ *
+ * [Description]:  Function to scan the ring once and recover its head (next record
+ * 					to write) and tail (oldest record)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM communication failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_init(void)
+{
+	AUDIT_RecordType page[AUDIT_RECORDS_PER_PAGE];
+	AUDIT_RecordType first, previous;
+	uint8 head = 0;
+	uint8 index, i;
+	boolean headFound = FALSE;
+
+	g_count = 0;
+	g_sequence = 0;
+
+	/*
+	 * The records are written in order, so the newest one is the valid record whose
+	 * follower is erased, torn or not the next sequence number.
+	 */
+	for (index = 0; index < AUDIT_NUM_OF_RECORDS; index += AUDIT_RECORDS_PER_PAGE)
+	{
+		if (EEPROM_readBlock(AUDIT_RECORD_ADDRESS(index), (uint8 *)page, sizeof(page)) == ERROR)
+			return ERROR;
+
+		for (i = 0; i < AUDIT_RECORDS_PER_PAGE; i++)
+		{
+			if (index + i == 0)
+			{
+				first = page[i];
+			}
+			else if ((headFound == FALSE) && AUDIT_isValid(&previous) &&
+					 (!AUDIT_isValid(&page[i]) || (page[i].sequence != (uint8)(previous.sequence + 1))))
+			{
+				head = index + i;
+				g_sequence = previous.sequence + 1;
+				headFound = TRUE;
+			}
+
+			if (AUDIT_isValid(&page[i]))
+				g_count++;
+			previous = page[i];
+		}
+	}
+
+	/* the break can also be between the last and the first record */
+	if ((headFound == FALSE) && AUDIT_isValid(&previous) &&
+		(!AUDIT_isValid(&first) || (first.sequence != (uint8)(previous.sequence + 1))))
+	{
+		head = 0;
+		g_sequence = previous.sequence + 1;
+	}
+
+	/* continue a partly written head page in RAM */
+	g_pageBase = head - (head % AUDIT_RECORDS_PER_PAGE);
+	g_pageCount = head % AUDIT_RECORDS_PER_PAGE;
+	g_flushedCount = g_pageCount;
+	if (g_pageCount != 0)
+	{
+		if (EEPROM_readBlock(AUDIT_RECORD_ADDRESS(g_pageBase), (uint8 *)g_page, g_pageCount * AUDIT_RECORD_SIZE) == ERROR)
+			return ERROR;
+	}
+
+	return SUCCESS;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_append
+ *
+ * [Description]:  Function to add a record to the ring. Records are collected in a page
+ * 					buffer and written when the page is full, so the append costs one
+ * 					page write per AUDIT_RECORDS_PER_PAGE records.
+ *
+ * [Args]:        event: one of AUDIT_EventType
+ * 				  user: user id
+ * 				  result: event result
+ * 				  time: seconds since boot (the low 24 bits are kept)
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM write failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_append(AUDIT_EventType event, uint8 user, uint8 result, uint32 time)
+{
+	AUDIT_RecordType *record = &g_page[g_pageCount];
+
+	record->sequence = g_sequence++;
+	record->event = event;
+	record->user = user;
+	record->result = result;
+	record->time[0] = (uint8)time;
+	record->time[1] = (uint8)(time >> 8);
+	record->time[2] = (uint8)(time >> 16);
+	record->crc = CRC8_update(CRC8_INITIAL_VALUE, (const uint8 *)record, AUDIT_CRC_COVERED_BYTES);
+
+	g_pageCount++;
+	if (g_count < AUDIT_NUM_OF_RECORDS)
+		g_count++;
+
+	if (g_pageCount == AUDIT_RECORDS_PER_PAGE)
+		return AUDIT_flush();
+
+	return SUCCESS;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_flush
+ *
+ * [Description]:  Function to write the buffered records of a partly filled page now,
+ * 					used for the events that must survive a power loss
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM write failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_flush(void)
+{
+	if (g_pageCount > g_flushedCount)
+	{
+		/* the records flushed before are the same bytes, the read-compare-write skips them */
+		if (EEPROM_updateBlock(AUDIT_RECORD_ADDRESS(g_pageBase), (const uint8 *)g_page,
+							   g_pageCount * AUDIT_RECORD_SIZE, NULL_PTR) == ERROR)
+			return ERROR;
+		g_flushedCount = g_pageCount;
+	}
+
+	if (g_pageCount == AUDIT_RECORDS_PER_PAGE)
+	{
+		g_pageBase = (g_pageBase + AUDIT_RECORDS_PER_PAGE) % AUDIT_NUM_OF_RECORDS;
+		g_pageCount = 0;
+		g_flushedCount = 0;
+	}
+	return SUCCESS;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_dump
+ *
+ * [Description]:  Function to stream the ring over UART from the oldest to the newest record:
+ * 					the number of records (one byte) then the binary records
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM read failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_dump(void)
+{
+	AUDIT_RecordType record;
+	uint8 head, index, i, j;
+	uint8 status = AUDIT_flush();
+
+	head = (g_pageBase + g_pageCount) % AUDIT_NUM_OF_RECORDS;
+	/* the tail is count records behind the head */
+	index = (head + AUDIT_NUM_OF_RECORDS - g_count) % AUDIT_NUM_OF_RECORDS;
+
+	UART_sendByte(g_count);
+	for (i = 0; i < g_count; i++)
+	{
+		/* one record at a time, the stream needs no buffer */
+		if (EEPROM_readBlock(AUDIT_RECORD_ADDRESS(index), (uint8 *)&record, AUDIT_RECORD_SIZE) == ERROR)
+			status = ERROR;
+
+		for (j = 0; j < AUDIT_RECORD_SIZE; j++)
+		{
+			UART_sendByte(((uint8 *)&record)[j]);
+		}
+		index = (index + 1) % AUDIT_NUM_OF_RECORDS;
+	}
+	return status;
+}
@@ -0,0 +1,137 @@
+/******************************************************************************
+ *
+ * Module: Audit log
+ *
+ * File Name: audit_log.h
+ *
+ * Description: Header file for the append-only access audit log ring kept in the external EEPROM
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef AUDIT_LOG_H_
+#define AUDIT_LOG_H_
+
+#include "std_types.h"
+#include "external_eeprom.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+/* the ring takes the EEPROM after the log storage region */
+#define AUDIT_START_ADDRESS				0x600
+#define AUDIT_SIZE						(EEPROM_SIZE - AUDIT_START_ADDRESS)
+
+#define AUDIT_RECORD_SIZE				8
+#define AUDIT_RECORDS_PER_PAGE			(EEPROM_PAGE_SIZE / AUDIT_RECORD_SIZE)
+#define AUDIT_NUM_OF_RECORDS			(AUDIT_SIZE / AUDIT_RECORD_SIZE)
+
+#define AUDIT_DEFAULT_USER				0
+
+#define AUDIT_RESULT_SUCCESS			1
+#define AUDIT_RESULT_FAIL				0
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum
+{
+	AUDIT_EVENT_BOOT,AUDIT_EVENT_UNLOCK,AUDIT_EVENT_WRONG_PASSWORD,AUDIT_EVENT_LOCKOUT,
+	AUDIT_EVENT_PASSWORD_SET,AUDIT_EVENT_DOOR_FAULT,AUDIT_EVENT_MOTOR_FAULT,
+	AUDIT_NUM_OF_EVENTS
+}AUDIT_EventType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: AUDIT_RecordType
+ *
+ * [Description]: Fixed width binary record, AUDIT_RECORDS_PER_PAGE records per EEPROM page
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * sequence: incremented by every record, the break in the sequence marks the ring head
+	 */
+			uint8	sequence;
+	/*
+	 * event: one of AUDIT_EventType, an erased record (0xFF) is not a valid event
+	 */
+			uint8	event;
+	/*
+	 * user: the user that caused the event
+	 */
+			uint8	user;
+	/*
+	 * result: AUDIT_RESULT_SUCCESS/AUDIT_RESULT_FAIL or an event specific value
+	 */
+			uint8	result;
+	/*
+	 * time: seconds since the last AUDIT_EVENT_BOOT, 24 bits (194 days) low byte first
+	 */
+			uint8	time[3];
+	/*
+	 * crc: CRC-8 of all the previous members, a torn or half erased record fails it
+	 */
+			uint8	crc;
+}AUDIT_RecordType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_init
+ *
+ * [Description]:  Function to scan the ring once and recover its head (next record
+ * 					to write) and tail (oldest record)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM communication failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_init(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_append
+ *
+ * [Description]:  Function to add a record to the ring. Records are collected in a page
+ * 					buffer and written when the page is full, so the append costs one
+ * 					page write per AUDIT_RECORDS_PER_PAGE records.
+ *
+ * [Args]:        event: one of AUDIT_EventType
+ * 				  user: user id
+ * 				  result: event result
+ * 				  time: seconds since boot (the low 24 bits are kept)
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM write failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_append(AUDIT_EventType event, uint8 user, uint8 result, uint32 time);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_flush
+ *
+ * [Description]:  Function to write the buffered records of a partly filled page now,
+ * 					used for the events that must survive a power loss
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM write failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_flush(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: AUDIT_dump
+ *
+ * [Description]:  Function to stream the ring over UART from the oldest to the newest record:
+ * 					the number of records (one byte) then the binary records
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM read failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 AUDIT_dump(void);
+
+#endif /* AUDIT_LOG_H_ */
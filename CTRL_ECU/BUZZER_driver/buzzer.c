@@ -1,61 +1,201 @@
-
-/******************************************************************************
- *
- * Module: Buzzer driver
- *
- * File Name: buzzer.c
- *
- * Description: Buzzer driver source file
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-
-#include "buzzer.h"
-
-/*-------------------------------------------------------------------------------
- *                       Functions Definitions                           		 *
---------------------------------------------------------------------------------*/
-/*-------------------------------------------------------------------------------
- * [Function Name]: Buzzer_init
- *
- * [Description]:  Function to initialize the Buzzer
- *
- * [Args]:        void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Buzzer_init (void)
-{
-	GPIO_setupPinDirection(BUZZER_PORT_ID, BUZZER_PIN_ID, PIN_OUTPUT);
-	Buzzer_OFF();
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Buzzer_ON
- *
- * [Description]:  Function to turn the Buzzer on when danger mission executes
- *
- * [Args]:        void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Buzzer_ON (void)
-{
-	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_HIGH);
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Buzzer_OFF
- *
- * [Description]:  Function to turn the Buzzer off
- *
- * [Args]:        void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Buzzer_OFF (void)
-{
-	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
-}
+/******************************************************************************
+ *
+ * Module: Buzzer driver
+ *
+ * File Name: buzzer.c
+ *
+ * Description: Buzzer driver source file
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "buzzer.h"
+#include <avr/pgmspace.h> /* To keep the pattern tables in flash */
+
+#if (BUZZER_TIMER_CLOCK_HZ / 1000UL) > 256
+#error "The buzzer silences need a compare value above 255, use a bigger prescaler"
+#endif
+
+/*-------------------------------------------------------------------------------
+ *                       Global Variables                           		 *
+--------------------------------------------------------------------------------*/
+/* Alarm: two tones, until Buzzer_stop */
+static const BUZZER_NoteType g_alarmNotes[] PROGMEM =
+{
+	BUZZER_NOTE(2500,250),BUZZER_NOTE(1800,250)
+};
+
+/* Key click: one short high tone */
+static const BUZZER_NoteType g_clickNotes[] PROGMEM =
+{
+	BUZZER_NOTE(3000,15)
+};
+
+/* Success: rising C major arpeggio */
+static const BUZZER_NoteType g_successNotes[] PROGMEM =
+{
+	BUZZER_NOTE(1047,100),BUZZER_REST(30),BUZZER_NOTE(1319,100),BUZZER_REST(30),BUZZER_NOTE(1568,200)
+};
+
+/* Pattern table, in BUZZER_PatternIdType order */
+static const BUZZER_PatternType g_patterns[BUZZER_NUM_OF_PATTERNS] PROGMEM =
+{
+	{g_alarmNotes, sizeof(g_alarmNotes) / sizeof(BUZZER_NoteType), BUZZER_REPEAT_FOREVER},	/* BUZZER_ALARM */
+	{g_clickNotes, sizeof(g_clickNotes) / sizeof(BUZZER_NoteType), 1},						/* BUZZER_CLICK */
+	{g_successNotes, sizeof(g_successNotes) / sizeof(BUZZER_NoteType), 1}					/* BUZZER_SUCCESS */
+};
+
+/* Pattern playing, shared with the Timer2 call back */
+static volatile boolean g_playing = FALSE;
+static volatile BUZZER_PatternIdType g_pattern = BUZZER_ALARM;
+static const BUZZER_NoteType *g_notes;
+static uint8 g_length;
+static uint8 g_noteIndex;
+static uint8 g_repeatsLeft;
+static uint16 g_matchesLeft;
+
+/*-------------------------------------------------------------------------------
+ *                      Functions Prototypes(Private)                          *
+--------------------------------------------------------------------------------*/
+static void Buzzer_loadNote(void);
+static void Buzzer_silence(void);
+static void Buzzer_timerCallBack(void);
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*
+ * Description :
+ * Start the note g_noteIndex: its frequency, the pin connected or not, its duration.
+ */
+static void Buzzer_loadNote(void)
+{
+	const BUZZER_NoteType *note = &g_notes[g_noteIndex];
+
+	Timer_setCompareValue(pgm_read_byte(&note->compare), BUZZER_TIMER_ID);
+	Timer_setCompareOutput(pgm_read_byte(&note->sound), BUZZER_TIMER_ID);
+	g_matchesLeft = pgm_read_word(&note->matches);
+}
+
+/*
+ * Description :
+ * Nothing to play: the pin is disconnected and low, the timer counts the silence.
+ */
+static void Buzzer_silence(void)
+{
+	g_playing = FALSE;
+	Timer_setCompareOutput(FALSE, BUZZER_TIMER_ID);
+	Timer_setCompareValue(BUZZER_REST_COMPARE, BUZZER_TIMER_ID);
+}
+
+/*
+ * Description :
+ * Once per compare match: count the matches of the note, then go on with the next note.
+ * Called right after the counter restarted, so the new compare value takes effect at once.
+ */
+static void Buzzer_timerCallBack(void)
+{
+	if((g_playing == FALSE) || (--g_matchesLeft != 0))
+	{
+		return;
+	}
+
+	if(++g_noteIndex == g_length)
+	{
+		g_noteIndex = 0;
+		if((g_repeatsLeft != BUZZER_REPEAT_FOREVER) && (--g_repeatsLeft == 0))
+		{
+			Buzzer_silence();
+			return;
+		}
+	}
+	Buzzer_loadNote();
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_init
+ *
+ * [Description]:  Function to initialize the Buzzer: the OC2 pin and the Timer2 tone
+ * 					generator, silent
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Buzzer_init (void)
+{
+	TIMER_ConfigType tone_configuration = {BUZZER_TIMER_ID,BUZZER_TIMER_PRESCALER,COMPARE_TOGGLE_MODE,0,BUZZER_REST_COMPARE};
+
+	GPIO_STATIC_SETUP_PIN_DIRECTION(BUZZER_PORT_ID, BUZZER_PIN_ID, PIN_OUTPUT);
+	GPIO_STATIC_WRITE_PIN(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
+
+	Timer_setCallBack(Buzzer_timerCallBack, BUZZER_TIMER_ID);
+	Timer_init(&tone_configuration);
+	Buzzer_silence();
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_play
+ *
+ * [Description]:  Function to start a pattern, it plays in the background from the Timer2
+ * 					call back. A new pattern replaces the one playing, except the alarm:
+ * 					only Buzzer_stop ends it.
+ *
+ * [Args]:        pattern: one of BUZZER_PatternIdType
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Buzzer_play (BUZZER_PatternIdType pattern)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	if((g_playing == FALSE) || (g_pattern != BUZZER_ALARM))
+	{
+		g_pattern = pattern;
+		g_notes = (const BUZZER_NoteType *)pgm_read_ptr(&g_patterns[pattern].notes);
+		g_length = pgm_read_byte(&g_patterns[pattern].length);
+		g_repeatsLeft = pgm_read_byte(&g_patterns[pattern].repeats);
+		g_noteIndex = 0;
+		Buzzer_loadNote();
+		g_playing = TRUE;
+	}
+	SREG = sreg;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_stop
+ *
+ * [Description]:  Function to stop the pattern playing
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Buzzer_stop (void)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	Buzzer_silence();
+	SREG = sreg;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_isPlaying
+ *
+ * [Description]:  Function to check whether a pattern is playing
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      TRUE while a pattern is playing
+ *
+ ----------------------------------------------------------------------------------*/
+boolean Buzzer_isPlaying (void)
+{
+	return g_playing;
+}
@@ -1,63 +1,145 @@
-/******************************************************************************
- *
- * Module: Buzzer driver
- *
- * File Name: buzzer.h
- *
- * Description: Buzzer driver header file
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-
-#ifndef BUZZER_H_
-#define BUZZER_H_
-
-#include "gpio.h"
-
-/*-------------------------------------------------------------------------------
- *                       Definitions                         					 *
---------------------------------------------------------------------------------*/
-#define BUZZER_PORT_ID 	PORTC_ID
-#define BUZZER_PIN_ID	PIN4_ID
-
-/*-------------------------------------------------------------------------------
- *                       Functions Prototypes                          			 *
---------------------------------------------------------------------------------*/
-/*-------------------------------------------------------------------------------
- * [Function Name]: Buzzer_init
- *
- * [Description]:  Function to initialize the Buzzer
- *
- * [Args]:        void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Buzzer_init (void);
-
-/*-------------------------------------------------------------------------------
- * [Function Name]: Buzzer_ON
- *
- * [Description]:  Function to turn the Buzzer on when danger mission executes
- *
- * [Args]:        void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Buzzer_ON (void);
-
-/*-------------------------------------------------------------------------------
- * [Function Name]: Buzzer_OFF
- *
- * [Description]:  Function to turn the Buzzer off
- *
- * [Args]:        void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Buzzer_OFF (void);
-
-#endif /* BUZZER_H_ */
+/******************************************************************************
+ *
+ * Module: Buzzer driver
+ *
+ * File Name: buzzer.h
+ *
+ * Description: Buzzer driver header file
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef BUZZER_H_
+#define BUZZER_H_
+
+#include "gpio.h"
+#include "timer.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+/* Passive buzzer on OC2, the tone is the Timer2 square wave */
+#define BUZZER_PORT_ID 	PORTD_ID
+#define BUZZER_PIN_ID	PIN7_ID
+#define BUZZER_TIMER_ID				TIMER_2_ID
+#define BUZZER_TIMER_PRESCALER		F_CPU_64
+#define BUZZER_TIMER_CLOCK_HZ		(F_CPU / 64)
+
+/*
+ * Compare value of a tone: two compare matches per period. With F_CPU/64 the tones
+ * go from 245 Hz (255) to 3.9 kHz (15).
+ */
+#define BUZZER_COMPARE(freq_hz)		((uint8)((BUZZER_TIMER_CLOCK_HZ / (2UL * (freq_hz))) - 1))
+/* Compare value of the silences: one compare match per ms */
+#define BUZZER_REST_COMPARE			((uint8)((BUZZER_TIMER_CLOCK_HZ / 1000UL) - 1))
+
+/* A note of the pattern tables: a tone or a silence of ms milliseconds */
+#define BUZZER_NOTE(freq_hz,ms)		{BUZZER_COMPARE(freq_hz), (uint16)((2UL * (freq_hz) * (ms)) / 1000), TRUE}
+#define BUZZER_REST(ms)				{BUZZER_REST_COMPARE, (uint16)(ms), FALSE}
+
+/* repeats of a pattern that plays until Buzzer_stop */
+#define BUZZER_REPEAT_FOREVER		0
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum
+{
+	BUZZER_ALARM,BUZZER_CLICK,BUZZER_SUCCESS,BUZZER_NUM_OF_PATTERNS
+}BUZZER_PatternIdType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: BUZZER_NoteType
+ *
+ * [Description]: A note of a pattern table (kept in flash)
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * compare: Timer2 compare value, the frequency of the tone
+	 */
+			uint8	compare;
+	/*
+	 * matches: duration in compare matches
+	 */
+			uint16	matches;
+	/*
+	 * sound: FALSE for a silence
+	 */
+			boolean	sound;
+}BUZZER_NoteType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: BUZZER_PatternType
+ *
+ * [Description]: A pattern of the pattern table (kept in flash)
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * notes, length: the note table of the pattern
+	 */
+			const BUZZER_NoteType	*notes;
+			uint8					length;
+	/*
+	 * repeats: how many times the notes are played, BUZZER_REPEAT_FOREVER until Buzzer_stop
+	 */
+			uint8					repeats;
+}BUZZER_PatternType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_init
+ *
+ * [Description]:  Function to initialize the Buzzer: the OC2 pin and the Timer2 tone
+ * 					generator, silent
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Buzzer_init (void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_play
+ *
+ * [Description]:  Function to start a pattern, it plays in the background from the Timer2
+ * 					call back. A new pattern replaces the one playing, except the alarm:
+ * 					only Buzzer_stop ends it.
+ *
+ * [Args]:        pattern: one of BUZZER_PatternIdType
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Buzzer_play (BUZZER_PatternIdType pattern);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_stop
+ *
+ * [Description]:  Function to stop the pattern playing
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Buzzer_stop (void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Buzzer_isPlaying
+ *
+ * [Description]:  Function to check whether a pattern is playing
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      TRUE while a pattern is playing
+ *
+ ----------------------------------------------------------------------------------*/
+boolean Buzzer_isPlaying (void);
+
+#endif /* BUZZER_H_ */
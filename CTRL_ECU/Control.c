@@ -1,212 +1,231 @@
-/******************************************************************************
- *
- * Module: CTRL ECU main function
- *
- * File Name: Control.c
- *
- * Description: Door Locker Security System (Control ECU)
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-
-#include "CTRL_supportingFunctions.h"
-
-
-int main ()
-{
-	SREG|=(1<<7); /*I-bit enable*/
-
-	/*INITIALIZATION AND CONFIGURATION*/
-	/*Uart Initialization */
-	Uart_ConfigType UART_Configuration ={BIT_8,NO_PARITY,ONE_STOP_BIT,BAUD_RATE_9600};
-	UART_init(&UART_Configuration);
-
-	/*Timer Initialization */
-	TIMER_ConfigType Timer_Configuration={TIMER_1_ID,F_CPU_1024,COMPARE_MODE,0,7813};
-	Timer_init(&Timer_Configuration);
-	Timer_setCallBack(Timer_callBack, TIMER_1_ID);
-
-	/*TWI Initialization */
-	TWI_ConfigType TWI_configuretion ={TWI_Prescaler_1,0x02,TWI_CONTROL_ECU_ADDRESS};
-	TWI_init(&TWI_configuretion);
-
-	/*DC motor initialization*/
-	DcMotor_init();
-	/*Buzzer initialization*/
-	Buzzer_init();
-	/*----------------------------------------------------------
-	 *						 Control interface
-		 ---------------------------------------------------------*/
-	/*
-	 * -First time to visit the program:
-	 * 				The program receives 2 passwords, the initialized and the its confirmation
-	 * 				and then it sends them to the CTRL ECU via UART to check if they are matched or not
-	 * 				>In case they are matched: save them to the EEPROM in the CTRL ECU
-	 * 				>In case they are not matched: ask the user to try again until matching occurs
-	 */
-	Setting_password_CTRL();
-	/*
-	 an array to store the password received from the HMI*/
-	uint8 recieved_password[PASSWORD_LENGTH];
-
-	/*
-	 * variable used to count the number of Un-matching occurance
-	 */
-	uint8 num_wrong_pass_attemps=0;
-
-	/*
-	 * variable to store received option from the user interface
-	 */
-	uint8 screen_options=0;
-
-	/*
-	 * variable used to store the received byte via UART*/
-	uint8 receivedByte=0;
-
-	while(1){
-
-
-		if (UART_recieveByte() == READY){
-
-			Receive_password_from_HMI_ECU(recieved_password);
-
-			/*
-			 * receive option desired by user from HMI ECU
-			 * >>>   '+' :  OPEN_DOOR_OPTION
-			 * >>>	 '-' : CHANGE_PASSWORD_OPTION
-			 */
-			screen_options = UART_recieveByte();
-
-			/* if the option is '+'	 */
-			if (screen_options == OPEN_DOOR_OPTION){
-				/*compare between the received password and the one stored to the EEPROM*/
-				receivedByte=Compare_passwords(g_password,recieved_password);
-
-				/*if the received password is matched with stored Password*/
-				if (receivedByte == PASSOWRD_MATCH)
-				{
-
-					/*
-					 * send an Opening door action to the HMI ECU for the passwords are matched
-					 */
-					UART_sendByte(Opening_Door_Action);
-
-					/*
-					 * reset the counter of wrong password received from HMI by user
-					 * as if one matched password recieved will break the counter to start again from zero
-					 */
-					num_wrong_pass_attemps=0;
-
-					/*
-					 * starting door tasks:
-					 * 		> open the door: 15 sec
-					 * 		> then hold it for some time: 3 sec
-					 * 		> then close it: 15 sec
-					 */
-					Door_tasksCTRL();
-
-				}
-				/*if the received password is Un-matched with the stored Password*/
-				else if (receivedByte == PASSWORD_UNMATCH)
-				{
-					/*
-					 * Increment the counter of wrong password received from HMI by user
-					 */
-					num_wrong_pass_attemps++;
-
-					/*if the unmatched trials reach the max number of allowed wrong trial*/
-					if (num_wrong_pass_attemps == NUMBER_OF_WRONG_PASSWORD_ATTEMPTS)
-					{
-						/*
-						 * sending password state to HMI-ECU telling that the entered password by user
-						 * 		is mismatched with the real password application for 3 times consecutively
-						 * 		so the lCD in HMI-ECU show state of Danger
-						 */
-						UART_sendByte(Danger);
-
-						/*
-						 * start execution of Danger mission
-						 * 		buzzer will work by high sound to show the danger state
-						 */
-						dangerMission();
-
-						/*
-						 * reset the counter of wrong password received from HMI by user
-						 */
-						num_wrong_pass_attemps=0;
-
-					}
-					else{
-						/*
-						 * sending password state to HMI-ECU telling that the entered password by user
-						 * 		is mismatched with the real password application
-						 */
-						UART_sendByte(PASSWORD_UNMATCH);
-					}
-				}
-			}
-			/* if the option is '-'	 */
-			else if (screen_options == CHANGE_PASSWORD_OPTION) {
-
-				/*compare between the received password and the one stored to the EEPROM*/
-				receivedByte=Compare_passwords(g_password, recieved_password);
-
-				/*if the received password is matched with stored Password*/
-				if ( receivedByte== PASSOWRD_MATCH) {
-					/*
-					 * sending to HMI-ECU that password matched and tell it to change password
-					 */
-					UART_sendByte(Changing_Password_Action);
-
-					num_wrong_pass_attemps=0;
-
-					Setting_password_CTRL();
-
-				}
-				/*if the received password is unmatched with stored Password*/
-				else if(receivedByte==PASSWORD_UNMATCH){
-
-					/*
-					 * Increment the counter of wrong password received from HMI by user
-					 * 		to use it in case repeated Mismatched password(may be thief)
-					 */
-					num_wrong_pass_attemps++;
-
-					/*if the unmatched trials reach the max number of allowed wrong trial*/
-					if (num_wrong_pass_attemps == NUMBER_OF_WRONG_PASSWORD_ATTEMPTS){
-
-						/*
-						 * sending password state to HMI-ECU telling that the entered password by user
-						 * 		is mismatched with the real password application for 3 times consecutively
-						 * 		so the lCD in HMI-ECU show state of Danger
-						 */
-						UART_sendByte(Danger);
-
-						/*
-						 * start execution of Danger mission
-						 * 		buzzer will work by high sound to show the danger state
-						 */
-						dangerMission();
-
-						/*
-						 * reset the counter of wrong password received from HMI by user
-						 */
-						num_wrong_pass_attemps=0;
-
-					}
-					else
-					{
-						UART_sendByte(PASSWORD_UNMATCH);
-					}
-				}
-			}
-		}
-	}
-
-	return 0;
-
-}
-
-
-
+/******************************************************************************
+ *
+ * Module: CTRL ECU main function
+ *
+ * File Name: Control.c
+ *
+ * Description: Door Locker Security System (Control ECU)
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "CTRL_supportingFunctions.h"
+
+
+int main ()
+{
+	SREG|=(1<<7); /*I-bit enable*/
+
+	/*INITIALIZATION AND CONFIGURATION*/
+	/*Uart Initialization */
+	Uart_ConfigType UART_Configuration ={BIT_8,NO_PARITY,ONE_STOP_BIT,BAUD_RATE_9600};
+	UART_init(&UART_Configuration);
+
+	/*Timer Initialization: the system tick, TICKS_PER_SECOND interrupts per second */
+	TIMER_ConfigType Timer_Configuration={TIMER_1_ID,TICK_TIMER_PRESCALER,COMPARE_MODE,0,TICK_TIMER_COMPARE_VALUE};
+	Timer_init(&Timer_Configuration);
+	Timer_setCallBack(Timer_callBack, TIMER_1_ID);
+
+	/*TWI Initialization */
+	TWI_ConfigType TWI_configuretion ={TWI_Prescaler_1,0x02,TWI_CONTROL_ECU_ADDRESS};
+	TWI_init(&TWI_configuretion);
+
+	/*DC motor initialization*/
+	DcMotor_init();
+	/*Door position initialization: end stops and encoder on the external interrupts*/
+	DOOR_init();
+	/*Motor current monitor: a stall or an overcurrent stops the door*/
+	CURRENT_setCallBack(Motor_faultCallBack);
+	CURRENT_init();
+	/*Buzzer initialization*/
+	Buzzer_init();
+	/*----------------------------------------------------------
+	 *						 Control interface
+		 ---------------------------------------------------------*/
+	/*
+	 * build the log storage index and the audit log ring, restore the lockout and load the
+	 * newest valid credential record from the EEPROM, then tell the HMI ECU whether a
+	 * password is already saved
+	 */
+	uint8 password_saved = Load_storage();
+
+	while (UART_recieveByte() != PASSWORD_STATUS_REQUEST);
+	/*
+	 * the EEPROM does not answer: the saved password is unknown, so the first time setup is
+	 * refused. The HMI ECU shows the fault and asks again, the EEPROM is read again every time
+	 */
+	while (password_saved == ERROR)
+	{
+		UART_sendByte(STORAGE_FAULT);
+		while (UART_recieveByte() != PASSWORD_STATUS_REQUEST);
+		password_saved = Load_storage();
+	}
+	Record_auditEvent(AUDIT_EVENT_BOOT, password_saved);
+	UART_sendByte((password_saved == SUCCESS) ? PASSWORD_SAVED : PASSWORD_NOT_SAVED);
+
+	/*
+	 * -First time to visit the program (no valid credential record):
+	 * 				The program receives 2 passwords, the initialized and the its confirmation
+	 * 				and then it sends them to the CTRL ECU via UART to check if they are matched or not
+	 * 				>In case they are matched: save them to the EEPROM in the CTRL ECU
+	 * 				>In case they are not matched: ask the user to try again until matching occurs
+	 */
+	if (password_saved == CREDENTIAL_NOT_SAVED)
+	{
+		Setting_password_CTRL();
+	}
+	/*
+	 an array to store the password received from the HMI*/
+	uint8 recieved_password[PASSWORD_LENGTH];
+
+	/*
+	 * variable used to count the number of Un-matching occurance
+	 * (inside the failure window of the lockout manager)
+	 */
+	uint8 num_wrong_pass_attemps=0;
+
+	/*
+	 * variable used to store the remaining lockout time in seconds*/
+	uint16 lockout_seconds=0;
+
+	/*
+	 * variable to store received option from the user interface
+	 */
+	uint8 screen_options=0;
+
+	/*
+	 * variable used to store the received byte via UART*/
+	uint8 receivedByte=0;
+
+	/*
+	 * variable used to store the request byte received from the HMI ECU*/
+	uint8 request=0;
+
+	while(1){
+
+		request = UART_recieveByte();
+
+		/*
+		 * the HMI ECU was reset while this ECU kept running: the password is saved already
+		 */
+		if (request == PASSWORD_STATUS_REQUEST){
+			UART_sendByte(PASSWORD_SAVED);
+		}
+		/*
+		 * service tool on the UART: stream the audit log
+		 */
+		else if (request == AUDIT_DUMP_REQUEST){
+			AUDIT_dump();
+		}
+		else if (request == READY){
+
+			/* key click while the password comes in, played in the background */
+			Buzzer_play(BUZZER_CLICK);
+			Receive_password_from_HMI_ECU(recieved_password);
+
+			/*
+			 * receive option desired by user from HMI ECU
+			 * >>>   '+' :  OPEN_DOOR_OPTION
+			 * >>>	 '-' : CHANGE_PASSWORD_OPTION
+			 * >>>	 '*' : AUDIT_SUMMARY_OPTION (maintenance chord of the keypad)
+			 */
+			screen_options = UART_recieveByte();
+
+			/*
+			 * during a lockout the password is not checked, the HMI ECU is told at once
+			 * how long the lockout still lasts
+			 */
+			lockout_seconds = LOCKOUT_getRemainingSeconds(Get_uptimeTicks());
+			if (lockout_seconds != 0){
+				Send_lockoutState(lockout_seconds);
+				continue;
+			}
+
+			/*compare between the received password and the one stored to the EEPROM*/
+			receivedByte=Compare_passwords(g_password,recieved_password);
+
+			/*if the received password is matched with stored Password*/
+			if (receivedByte == PASSOWRD_MATCH)
+			{
+				/*
+				 * a matched password clears the wrong passwords and the lockout backoff
+				 */
+				LOCKOUT_recordSuccess();
+
+				/* if the option is '+'	 */
+				if (screen_options == OPEN_DOOR_OPTION){
+					/*
+					 * send an Opening door action to the HMI ECU for the passwords are matched
+					 */
+					UART_sendByte(Opening_Door_Action);
+					Record_auditEvent(AUDIT_EVENT_UNLOCK, AUDIT_RESULT_SUCCESS);
+					Buzzer_play(BUZZER_SUCCESS);
+
+					/*
+					 * starting door tasks:
+					 * 		> open the door until the open end stop (15 sec at most)
+					 * 		> then hold it for some time: 3 sec
+					 * 		> then close it until the closed end stop (15 sec at most)
+					 */
+					Door_tasksCTRL();
+				}
+				/* if the option is '-'	 */
+				else if (screen_options == CHANGE_PASSWORD_OPTION){
+					/*
+					 * sending to HMI-ECU that password matched and tell it to change password
+					 */
+					UART_sendByte(Changing_Password_Action);
+
+					Setting_password_CTRL();
+				}
+				/* if the option is '*'	 */
+				else if (screen_options == AUDIT_SUMMARY_OPTION){
+					/*
+					 * the audit log is only shown to a user who knows the password
+					 */
+					UART_sendByte(Audit_Summary_Action);
+					AUDIT_dump();
+				}
+			}
+			/*if the received password is Un-matched with the stored Password*/
+			else if (receivedByte == PASSWORD_UNMATCH)
+			{
+				/*
+				 * count the wrong password, the lockout manager keeps it in the EEPROM
+				 * with the wrong passwords of the failure window
+				 */
+				num_wrong_pass_attemps = LOCKOUT_recordFailure(Get_uptimeTicks());
+				Record_auditEvent(AUDIT_EVENT_WRONG_PASSWORD, num_wrong_pass_attemps);
+
+				/*if the unmatched trials reach the max number of allowed wrong trial*/
+				if (num_wrong_pass_attemps == NUMBER_OF_WRONG_PASSWORD_ATTEMPTS)
+				{
+					/* the lockout is written now, not when the page buffer is full */
+					Record_auditEvent(AUDIT_EVENT_LOCKOUT, LOCKOUT_getLevel());
+					AUDIT_flush();
+
+					/*
+					 * start execution of Danger mission:
+					 * 		the lCD in HMI-ECU shows the lockout time and the buzzer sounds
+					 * 		the alarm in the background, this ECU keeps serving the requests
+					 */
+					dangerMission();
+				}
+				else{
+					/*
+					 * sending password state to HMI-ECU telling that the entered password by user
+					 * 		is mismatched with the real password application
+					 */
+					UART_sendByte(PASSWORD_UNMATCH);
+				}
+			}
+		}
+	}
+
+	return 0;
+
+}
+
+
+
@@ -0,0 +1,73 @@
+/******************************************************************************
+ *
+ * Module: Credential storage
+ *
+ * File Name: credential_storage.c
+ *
+ * Description: Source file for the power-fail safe password record kept in the external EEPROM
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "credential_storage.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CREDENTIAL_load
+ *
+ * [Description]:  Function to return the password of the newest valid record
+ * 					(LOG_init must be called before)
+ *
+ * [Args]:        password: a pointer to uint8 array of CREDENTIAL_LENGTH to be filled
+ *
+ * [Returns]:      SUCCESS if a valid record exists, CREDENTIAL_NOT_SAVED if there is none
+ * 				   (first time setup needed), ERROR in case of EEPROM communication failure
+ * 				   (the password is unknown, no first time setup)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 CREDENTIAL_load(uint8 *password)
+{
+	CREDENTIAL_RecordType record;
+	uint8 status;
+	uint8 i;
+
+	status = LOG_read(LOG_KEY_CREDENTIAL, (uint8 *)&record, sizeof(record));
+	if (status == ERROR)
+		return ERROR;
+
+	if ((status == LOG_NOT_FOUND) || (record.version != CREDENTIAL_VERSION))
+		return CREDENTIAL_NOT_SAVED;
+
+	for (i = 0; i < CREDENTIAL_LENGTH; i++)
+	{
+		password[i] = record.password[i];
+	}
+	return SUCCESS;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CREDENTIAL_save
+ *
+ * [Description]:  Function to append a new password record to the log storage
+ *
+ * [Args]:        password: a pointer to uint8 array of CREDENTIAL_LENGTH
+ *
+ * [Returns]:      SUCCESS if the new record is written and verified, ERROR otherwise
+ * 				   (the previous record is still the valid one in this case)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 CREDENTIAL_save(const uint8 *password)
+{
+	CREDENTIAL_RecordType record;
+	uint8 i;
+
+	record.version = CREDENTIAL_VERSION;
+	for (i = 0; i < CREDENTIAL_LENGTH; i++)
+	{
+		record.password[i] = password[i];
+	}
+	return LOG_write(LOG_KEY_CREDENTIAL, (const uint8 *)&record, sizeof(record));
+}
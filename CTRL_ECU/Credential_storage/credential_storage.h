@@ -0,0 +1,84 @@
+/******************************************************************************
+ *
+ * Module: Credential storage
+ *
+ * File Name: credential_storage.h
+ *
+ * Description: Header file for the power-fail safe password record kept in the external EEPROM
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef CREDENTIAL_STORAGE_H_
+#define CREDENTIAL_STORAGE_H_
+
+#include "std_types.h"
+#include "log_storage.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+#define CREDENTIAL_LENGTH				5
+
+/* increment when the record layout changes, records of other versions are ignored */
+#define CREDENTIAL_VERSION				2
+
+/* CREDENTIAL_load result when no password is saved (first time setup) */
+#define CREDENTIAL_NOT_SAVED			2
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: CREDENTIAL_RecordType
+ *
+ * [Description]: Value stored under LOG_KEY_CREDENTIAL in the log storage. The log
+ * 				  record around it carries the sequence number and the CRC, and a new
+ * 				  record never overwrites the previous one, so a save torn by a power
+ * 				  loss leaves the previous password valid.
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * version: CREDENTIAL_VERSION of the firmware that wrote the record
+	 */
+			uint8	version;
+	/*
+	 * password: the saved password digits
+	 */
+			uint8	password[CREDENTIAL_LENGTH];
+}CREDENTIAL_RecordType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CREDENTIAL_load
+ *
+ * [Description]:  Function to return the password of the newest valid record
+ * 					(LOG_init must be called before)
+ *
+ * [Args]:        password: a pointer to uint8 array of CREDENTIAL_LENGTH to be filled
+ *
+ * [Returns]:      SUCCESS if a valid record exists, CREDENTIAL_NOT_SAVED if there is none
+ * 				   (first time setup needed), ERROR in case of EEPROM communication failure
+ * 				   (the password is unknown, no first time setup)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 CREDENTIAL_load(uint8 *password);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CREDENTIAL_save
+ *
+ * [Description]:  Function to append a new password record to the log storage
+ *
+ * [Args]:        password: a pointer to uint8 array of CREDENTIAL_LENGTH
+ *
+ * [Returns]:      SUCCESS if the new record is written and verified, ERROR otherwise
+ * 				   (the previous record is still the valid one in this case)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 CREDENTIAL_save(const uint8 *password);
+
+#endif /* CREDENTIAL_STORAGE_H_ */
@@ -0,0 +1,189 @@
+/******************************************************************************
+ *
+ * Module: Current monitor
+ *
+ * File Name: current_monitor.c
+ *
+ * Description: Source file for the motor current monitor (stall and overcurrent
+ * 				detection on the H-bridge current sense)
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "current_monitor.h"
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+/* the last samples and their sum, the average costs the same for every sample */
+static uint16 g_samples[CURRENT_AVERAGE_SAMPLES];
+static uint16 g_sum = 0;
+static uint8 g_sampleIndex = 0;
+static volatile uint16 g_average = 0;
+
+/* stall threshold of the last duty seen, computed again only when the duty changes */
+static uint8 g_thresholdDuty = 0;
+static uint16 g_stallThreshold = 0xFFFF;
+static uint16 g_stallSamples = 0;
+
+static volatile CURRENT_FaultType g_fault = CURRENT_NO_FAULT;
+static void (*volatile g_CURRENT_callBackPtr)(CURRENT_FaultType) = NULL_PTR;
+
+/*------------------------------------------------------------------------------
+ *                      Functions Prototypes(Private)                          *
+-------------------------------------------------------------------------------*/
+static void CURRENT_sample(uint16 sample);
+static void CURRENT_trip(CURRENT_FaultType fault);
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*
+ * ADC call back: update the moving average and check it against the limits
+ */
+static void CURRENT_sample(uint16 sample)
+{
+	uint8 duty;
+
+	g_sum = g_sum - g_samples[g_sampleIndex] + sample;
+	g_samples[g_sampleIndex] = sample;
+	g_sampleIndex = (g_sampleIndex + 1) & (CURRENT_AVERAGE_SAMPLES - 1);
+	g_average = g_sum >> CURRENT_AVERAGE_SHIFT;
+
+	if(g_fault != CURRENT_NO_FAULT)
+	{
+		return;
+	}
+
+	if(g_average >= CURRENT_OVERCURRENT_COUNTS)
+	{
+		CURRENT_trip(CURRENT_OVERCURRENT);
+		return;
+	}
+
+	duty = DcMotor_getDuty();
+	if(duty != g_thresholdDuty)
+	{
+		g_thresholdDuty = duty;
+		g_stallThreshold = (duty == 0) ? 0xFFFF :
+				(uint16)(((uint32)CURRENT_LOCKED_ROTOR_COUNTS * CURRENT_STALL_PERCENT * duty) / (100UL * 255));
+	}
+
+	if(g_average < g_stallThreshold)
+	{
+		g_stallSamples = 0;
+	}
+	else if(++g_stallSamples >= CURRENT_STALL_SAMPLES)
+	{
+		CURRENT_trip(CURRENT_STALL);
+	}
+}
+
+/*
+ * Stop the motor at once and keep the fault
+ */
+static void CURRENT_trip(CURRENT_FaultType fault)
+{
+	DcMotor_Rotate(STOP);
+	g_fault = fault;
+	if(g_CURRENT_callBackPtr != NULL_PTR)
+	{
+		(*g_CURRENT_callBackPtr)(fault);
+	}
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_init
+ *
+ * [Description]:  Function to start the free running conversions of the current sense,
+ * 					every sample is checked from the ADC interrupt
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void CURRENT_init(void)
+{
+	ADC_ConfigType adc_configuration = {ADC_AVCC,CURRENT_ADC_PRESCALER};
+
+	ADC_init(&adc_configuration);
+	ADC_setCallBack(CURRENT_sample);
+	ADC_startFreeRunning(CURRENT_SENSE_CHANNEL);
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_setCallBack
+ *
+ * [Description]:  Function to set the function called (from the ADC interrupt) after a fault
+ * 					stopped the motor
+ *
+ * [Args]:        a_ptr: a pointer to a void function that takes the fault
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void CURRENT_setCallBack(void(*a_ptr)(CURRENT_FaultType))
+{
+	g_CURRENT_callBackPtr = a_ptr;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_getFault
+ *
+ * [Description]:  Function to get the fault that stopped the motor, it stays until CURRENT_clearFault
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      one of CURRENT_FaultType
+ *
+ ----------------------------------------------------------------------------------*/
+CURRENT_FaultType CURRENT_getFault(void)
+{
+	return g_fault;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_clearFault
+ *
+ * [Description]:  Function to clear the fault and restart the stall detection
+ * 					(before a new movement)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void CURRENT_clearFault(void)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	g_stallSamples = 0;
+	g_fault = CURRENT_NO_FAULT;
+	SREG = sreg;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_getAverage
+ *
+ * [Description]:  Function to get the moving average of the current
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      ADC counts, CURRENT_COUNTS_PER_AMPERE per A
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 CURRENT_getAverage(void)
+{
+	uint16 average;
+	uint8 sreg = SREG;
+
+	/* 16-bit value shared with the ADC interrupt */
+	cli();
+	average = g_average;
+	SREG = sreg;
+
+	return average;
+}
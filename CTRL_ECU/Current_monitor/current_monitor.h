@@ -0,0 +1,127 @@
+/******************************************************************************
+ *
+ * Module: Current monitor
+ *
+ * File Name: current_monitor.h
+ *
+ * Description: Header file for the motor current monitor (stall and overcurrent
+ * 				detection on the H-bridge current sense)
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef CURRENT_MONITOR_H_
+#define CURRENT_MONITOR_H_
+
+#include "std_types.h"
+#include "adc.h"
+#include "dc_motor.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+/*
+ * In-line current sense amplifier on a motor lead (it sees the motor current in both directions
+ * and in the PWM off time) on ADC0 (PA0), AVCC reference: 0.5 V per A, 102 counts per A. The free running ADC at F_CPU/128
+ * gives a sample every 208 us (4.8 kHz).
+ */
+#define CURRENT_SENSE_CHANNEL			0
+#define CURRENT_ADC_PRESCALER			ADC_F_CPU_128
+#define CURRENT_COUNTS_PER_AMPERE		102
+
+/* Moving average of the last samples (3.3 ms), must be a power of 2 */
+#define CURRENT_AVERAGE_SAMPLES			16
+#define CURRENT_AVERAGE_SHIFT			4
+
+/* Locked rotor current at the full duty (12 V / 2 ohm = 6 A) */
+#define CURRENT_LOCKED_ROTOR_COUNTS		(6 * CURRENT_COUNTS_PER_AMPERE)
+/* Overcurrent: more than a locked rotor can take, a short in the motor or its wiring */
+#define CURRENT_OVERCURRENT_COUNTS		((CURRENT_LOCKED_ROTOR_COUNTS * 11) / 10)
+/*
+ * Stall: the current stays above this part of the locked rotor current of the applied duty
+ * (there is no back EMF, the motor is not turning) for CURRENT_STALL_SAMPLES samples (150 ms),
+ * longer than the motor needs to spin up
+ */
+#define CURRENT_STALL_PERCENT			60
+#define CURRENT_STALL_SAMPLES			720
+
+#if ((1 << CURRENT_AVERAGE_SHIFT) != CURRENT_AVERAGE_SAMPLES)
+#error "CURRENT_AVERAGE_SHIFT does not match CURRENT_AVERAGE_SAMPLES"
+#endif
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum
+{
+	CURRENT_NO_FAULT,CURRENT_STALL,CURRENT_OVERCURRENT
+}CURRENT_FaultType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_init
+ *
+ * [Description]:  Function to start the free running conversions of the current sense,
+ * 					every sample is checked from the ADC interrupt
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void CURRENT_init(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_setCallBack
+ *
+ * [Description]:  Function to set the function called (from the ADC interrupt) after a fault
+ * 					stopped the motor
+ *
+ * [Args]:        a_ptr: a pointer to a void function that takes the fault
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void CURRENT_setCallBack(void(*a_ptr)(CURRENT_FaultType));
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_getFault
+ *
+ * [Description]:  Function to get the fault that stopped the motor, it stays until CURRENT_clearFault
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      one of CURRENT_FaultType
+ *
+ ----------------------------------------------------------------------------------*/
+CURRENT_FaultType CURRENT_getFault(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_clearFault
+ *
+ * [Description]:  Function to clear the fault and restart the stall detection
+ * 					(before a new movement)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void CURRENT_clearFault(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CURRENT_getAverage
+ *
+ * [Description]:  Function to get the moving average of the current
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      ADC counts, CURRENT_COUNTS_PER_AMPERE per A
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 CURRENT_getAverage(void);
+
+#endif /* CURRENT_MONITOR_H_ */
@@ -1,60 +1,317 @@
-/******************************************************************************
- *
- * Module: DC motor
- *
- * File Name: dc_motor.c
- *
- * Description: Source file for the ATmega16 DC motor driver
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-#include "dc_motor.h"
-
-/*******************************************************************************
- *                      Functions Definitions                                  *
- *******************************************************************************/
-/*
- * Description :
- * The Function responsible for setup the direction for the two motor pins through the GPIO driver.
- * Stop at the DC-Motor at the beginning through the GPIO driver.
- */
-
-void DcMotor_init(void)
-
-{
-	/* Configure the direction for DC motor pins */
-	GPIO_setupPinDirection(MOTOR_PORT, MOTOR_INPUT1_PIN_ID	, PIN_OUTPUT);
-	GPIO_setupPinDirection(MOTOR_PORT, MOTOR_INPUT2_PIN_ID	, PIN_OUTPUT);
-
-	/*Stop the DC motor at the beginning*/
-	DcMotor_Rotate(STOP);
-}
-
-/*
- * Description:
- * The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor based on the state input state value.
- * Send the required duty cycle to the PWM driver based on the required speed value.
- */
-
-void DcMotor_Rotate(DcMotor_State state)
-{
-	switch(state)
-	{
-	case STOP:
-		GPIO_writePin(MOTOR_PORT, MOTOR_INPUT1_PIN_ID, LOGIC_LOW);
-		GPIO_writePin(MOTOR_PORT, MOTOR_INPUT2_PIN_ID, LOGIC_LOW);
-		break;
-
-	case CW:
-		GPIO_writePin(MOTOR_PORT, MOTOR_INPUT1_PIN_ID, LOGIC_LOW);
-		GPIO_writePin(MOTOR_PORT, MOTOR_INPUT1_PIN_ID, LOGIC_HIGH);
-		break;
-
-	case ACW:
-		GPIO_writePin(MOTOR_PORT, MOTOR_INPUT1_PIN_ID, LOGIC_HIGH);
-		GPIO_writePin(MOTOR_PORT, MOTOR_INPUT1_PIN_ID, LOGIC_LOW);
-		break;
-	}
-}
-
+/******************************************************************************
+ *
+ * Module: DC motor
+ *
+ * File Name: dc_motor.c
+ *
+ * Description: Source file for the ATmega16 DC motor driver
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+#include "dc_motor.h"
+#include <avr/pgmspace.h> /* To keep the ramp table in flash */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* A ramp entry scaled to the cruise duty at compile time */
+#define MOTOR_RAMP_DUTY(x)			((uint8)(((x) * (uint16)MOTOR_CRUISE_DUTY) / 255))
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+/*
+ * S-curve of the ramps (half a cosine period): the duty of every step of the acceleration,
+ * walked backwards for the deceleration. The slope is low at both ends so the door
+ * starts and lands without a jerk, the call back only reads the next entry.
+ */
+static const uint8 g_rampDuty[MOTOR_RAMP_STEPS] PROGMEM =
+{
+	MOTOR_RAMP_DUTY(1),MOTOR_RAMP_DUTY(2),MOTOR_RAMP_DUTY(5),MOTOR_RAMP_DUTY(10),
+	MOTOR_RAMP_DUTY(15),MOTOR_RAMP_DUTY(21),MOTOR_RAMP_DUTY(29),MOTOR_RAMP_DUTY(37),
+	MOTOR_RAMP_DUTY(47),MOTOR_RAMP_DUTY(57),MOTOR_RAMP_DUTY(67),MOTOR_RAMP_DUTY(79),
+	MOTOR_RAMP_DUTY(90),MOTOR_RAMP_DUTY(103),MOTOR_RAMP_DUTY(115),MOTOR_RAMP_DUTY(127),
+	MOTOR_RAMP_DUTY(140),MOTOR_RAMP_DUTY(152),MOTOR_RAMP_DUTY(165),MOTOR_RAMP_DUTY(176),
+	MOTOR_RAMP_DUTY(188),MOTOR_RAMP_DUTY(198),MOTOR_RAMP_DUTY(208),MOTOR_RAMP_DUTY(218),
+	MOTOR_RAMP_DUTY(226),MOTOR_RAMP_DUTY(234),MOTOR_RAMP_DUTY(240),MOTOR_RAMP_DUTY(245),
+	MOTOR_RAMP_DUTY(250),MOTOR_RAMP_DUTY(253),MOTOR_RAMP_DUTY(254),MOTOR_RAMP_DUTY(255)
+};
+
+/* Speed profile state, shared with the PWM call back */
+static volatile DcMotor_RampState g_rampState = MOTOR_IDLE;
+static volatile uint8 g_rampIndex = 0;
+static volatile uint16 g_periodsLeft = 0;
+/* FALSE: the cruise lasts until the motor is told to stop */
+static volatile boolean g_timedCruise = TRUE;
+/* the deceleration ends at this step, the motor stops at step 0 and keeps running otherwise */
+static volatile uint8 g_rampFloor = 0;
+/* duty written to the PWM timer */
+static volatile uint8 g_duty = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+/*
+ * Function responsible for the next step of the speed profile, once per PWM period
+ */
+static void DcMotor_pwmCallBack(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description :
+ * The Function responsible for setup the direction for the two motor pins and the enable pin through the GPIO driver.
+ * Start the PWM timer with a zero duty and stop the DC-Motor at the beginning.
+ */
+
+void DcMotor_init(void)
+
+{
+	TIMER_ConfigType pwm_configuration = {MOTOR_PWM_TIMER_ID,MOTOR_PWM_PRESCALER,FAST_PWM_MODE,0,0};
+
+	/* Configure the direction for DC motor pins */
+	GPIO_STATIC_SETUP_PIN_DIRECTION(MOTOR_PORT, MOTOR_INPUT1_PIN_ID	, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(MOTOR_PORT, MOTOR_INPUT2_PIN_ID	, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(MOTOR_ENABLE_PORT, MOTOR_ENABLE_PIN_ID, PIN_OUTPUT);
+
+	/*Stop the DC motor at the beginning*/
+	DcMotor_Rotate(STOP);
+
+	Timer_setCallBack(DcMotor_pwmCallBack, MOTOR_PWM_TIMER_ID);
+	Timer_init(&pwm_configuration);
+}
+
+/*
+ * Description :
+ * Write the duty of the PWM timer and keep it for DcMotor_getDuty.
+ */
+static void DcMotor_setDuty(uint8 duty)
+{
+	g_duty = duty;
+	Timer_setCompareValue(duty, MOTOR_PWM_TIMER_ID);
+}
+
+/*
+ * Description :
+ * Write the H-bridge inputs of a state in one masked write.
+ */
+static void DcMotor_setDirection(DcMotor_State state)
+{
+	switch(state)
+	{
+	case STOP:
+		GPIO_STATIC_WRITE_PORT_MASKED(MOTOR_PORT, MOTOR_PINS_MASK, MOTOR_STOP_PINS);
+		break;
+
+	case CW:
+		GPIO_STATIC_WRITE_PORT_MASKED(MOTOR_PORT, MOTOR_PINS_MASK, MOTOR_CW_PINS);
+		break;
+
+	case ACW:
+		GPIO_STATIC_WRITE_PORT_MASKED(MOTOR_PORT, MOTOR_PINS_MASK, MOTOR_ACW_PINS);
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Start the acceleration of a movement, called with the interrupts disabled.
+ */
+static void DcMotor_start(DcMotor_State state, boolean timed)
+{
+	/* the direction changes while the duty is zero */
+	DcMotor_setDuty(0);
+	DcMotor_setDirection(state);
+	g_timedCruise = timed;
+	g_rampFloor = 0;
+	g_rampIndex = 0;
+	g_periodsLeft = MOTOR_ACCELERATION_STEP_PERIODS;
+	g_rampState = MOTOR_ACCELERATING;
+}
+
+/*
+ * Description:
+ * The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor based on the state input state value.
+ * The change is immediate (full cruise duty or stopped), any movement in progress is cancelled.
+ * Both H-bridge inputs change in one write, there is no intermediate state between two pin writes.
+ */
+
+void DcMotor_Rotate(DcMotor_State state)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	g_rampState = MOTOR_IDLE;
+	DcMotor_setDirection(state);
+	DcMotor_setDuty((state == STOP) ? 0 : MOTOR_CRUISE_DUTY);
+	SREG = sreg;
+}
+
+/*
+ * Description:
+ * The function responsible for one door movement in the required direction: soft start, cruise and
+ * soft stop, MOTOR_TRAVEL_TIME_MS in total. It returns at once, the PWM call back runs the profile
+ * and stops the motor at the end. STOP starts the soft stop of a movement in progress.
+ */
+
+void DcMotor_move(DcMotor_State state)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	if(state == STOP)
+	{
+		/* the deceleration starts from the current step of the table */
+		if(g_rampState != MOTOR_IDLE)
+		{
+			g_rampFloor = 0;
+			g_rampState = MOTOR_DECELERATING;
+			g_periodsLeft = MOTOR_DECELERATION_STEP_PERIODS;
+		}
+	}
+	else
+	{
+		DcMotor_start(state, TRUE);
+	}
+	SREG = sreg;
+}
+
+/*
+ * Description:
+ * The function responsible for a soft start in the required direction, the motor then cruises
+ * until DcMotor_move(STOP), DcMotor_slowDown or DcMotor_Rotate(STOP) (movements ended by a sensor).
+ * STOP stops the motor at once.
+ */
+
+void DcMotor_run(DcMotor_State state)
+{
+	uint8 sreg = SREG;
+
+	if(state == STOP)
+	{
+		DcMotor_Rotate(STOP);
+		return;
+	}
+	cli();
+	DcMotor_start(state, FALSE);
+	SREG = sreg;
+}
+
+/*
+ * Description:
+ * The function responsible for decelerating a movement in progress to the MOTOR_CREEP_STEP duty
+ * and keeping it there, so the final approach to an end stop is slow.
+ */
+
+void DcMotor_slowDown(void)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	if(g_rampState != MOTOR_IDLE)
+	{
+		g_timedCruise = FALSE;
+		g_rampFloor = MOTOR_CREEP_STEP;
+		/* slower than the creep speed: the acceleration ends at the creep step */
+		if(g_rampIndex > MOTOR_CREEP_STEP)
+		{
+			g_rampState = MOTOR_DECELERATING;
+			g_periodsLeft = MOTOR_DECELERATION_STEP_PERIODS;
+		}
+	}
+	SREG = sreg;
+}
+
+/*
+ * Description:
+ * The function responsible for returning the duty applied to the motor (0-255).
+ */
+
+uint8 DcMotor_getDuty(void)
+{
+	return g_duty;
+}
+
+/*
+ * Description:
+ * The function responsible for returning the phase of the speed profile (MOTOR_IDLE once stopped).
+ */
+
+DcMotor_RampState DcMotor_getRampState(void)
+{
+	return g_rampState;
+}
+
+/*
+ * Description :
+ * Once per PWM period: count the periods of the current step, then load the next duty
+ * from the table. Every call does the same small amount of work.
+ */
+static void DcMotor_pwmCallBack(void)
+{
+	if((g_rampState == MOTOR_IDLE) || (--g_periodsLeft != 0))
+	{
+		return;
+	}
+
+	switch(g_rampState)
+	{
+	case MOTOR_ACCELERATING:
+		DcMotor_setDuty(pgm_read_byte(&g_rampDuty[g_rampIndex]));
+		if((g_rampIndex == MOTOR_RAMP_STEPS - 1) || ((g_rampFloor != 0) && (g_rampIndex == g_rampFloor)))
+		{
+			g_rampState = MOTOR_CRUISING;
+			g_periodsLeft = (g_timedCruise == TRUE) ? MOTOR_CRUISE_PERIODS : 1;
+			/* no cruise at all: decelerate at once */
+			if(g_periodsLeft == 0)
+			{
+				g_rampState = MOTOR_DECELERATING;
+				g_periodsLeft = MOTOR_DECELERATION_STEP_PERIODS;
+			}
+		}
+		else
+		{
+			g_rampIndex++;
+			g_periodsLeft = MOTOR_ACCELERATION_STEP_PERIODS;
+		}
+		break;
+
+	case MOTOR_CRUISING:
+		if(g_timedCruise == FALSE)
+		{
+			/* cruise until told otherwise */
+			g_periodsLeft = 1;
+			break;
+		}
+		g_rampState = MOTOR_DECELERATING;
+		g_periodsLeft = MOTOR_DECELERATION_STEP_PERIODS;
+		break;
+
+	case MOTOR_DECELERATING:
+		if(g_rampIndex == 0)
+		{
+			/* end of the movement: the H-bridge is released */
+			DcMotor_setDuty(0);
+			DcMotor_setDirection(STOP);
+			g_rampState = MOTOR_IDLE;
+		}
+		else if(g_rampIndex == g_rampFloor)
+		{
+			/* creep speed reached */
+			g_rampState = MOTOR_CRUISING;
+			g_periodsLeft = 1;
+		}
+		else
+		{
+			g_rampIndex--;
+			DcMotor_setDuty(pgm_read_byte(&g_rampDuty[g_rampIndex]));
+			g_periodsLeft = MOTOR_DECELERATION_STEP_PERIODS;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
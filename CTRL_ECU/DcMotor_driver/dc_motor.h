@@ -1,56 +1,145 @@
-/******************************************************************************
- *
- * Module: DC Motor
- *
- * File Name: dc_motor.h
- *
- * Description: header file for the DC motor driver
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-
-#ifndef DC_MOTOR_H_
-#define DC_MOTOR_H_
-
-#include "gpio.h"
-#include "std_types.h"
-/*******************************************************************************
- *                                Definitions                                  *
- *******************************************************************************/
-#define MOTOR_PORT					PORTC_ID
-#define MOTOR_INPUT1_PIN_ID			PIN5_ID
-#define MOTOR_INPUT2_PIN_ID			PIN6_ID
-
-/*******************************************************************************
- *                         Types Declaration                                   *
- *******************************************************************************/
-
-typedef enum
-{
-	STOP,CW,ACW
-}DcMotor_State;
-
-
-/*******************************************************************************
- *                      Functions Prototypes                                   *
- *******************************************************************************/
-/*
- * Description :
- * The Function responsible for setup the direction for the two motor pins through the GPIO driver.
- * Stop at the DC-Motor at the beginning through the GPIO driver.
- */
-
-void DcMotor_init(void);
-
-/*
- * Description:
- * The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor based on the state input state value.
- * Send the required duty cycle to the PWM driver based on the required speed value.
- */
-
-void DcMotor_Rotate(DcMotor_State state);
-
-
-
-#endif /* DC_MOTOR_H_ */
+/******************************************************************************
+ *
+ * Module: DC Motor
+ *
+ * File Name: dc_motor.h
+ *
+ * Description: header file for the DC motor driver
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef DC_MOTOR_H_
+#define DC_MOTOR_H_
+
+#include "gpio.h"
+#include "std_types.h"
+#include "timer.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define MOTOR_PORT					PORTC_ID
+#define MOTOR_INPUT1_PIN_ID			PIN5_ID
+#define MOTOR_INPUT2_PIN_ID			PIN6_ID
+#define MOTOR_PINS_MASK				((1<<MOTOR_INPUT1_PIN_ID) | (1<<MOTOR_INPUT2_PIN_ID))
+
+/* H-bridge input levels of every state, IN1 = IN2 = 1 (brake through both sides) is never driven */
+#define MOTOR_STOP_PINS				0
+#define MOTOR_CW_PINS				(1<<MOTOR_INPUT1_PIN_ID)
+#define MOTOR_ACW_PINS				(1<<MOTOR_INPUT2_PIN_ID)
+
+/* H-bridge enable driven by the Timer0 fast PWM output (OC0) */
+#define MOTOR_ENABLE_PORT			PORTB_ID
+#define MOTOR_ENABLE_PIN_ID			PIN3_ID
+#define MOTOR_PWM_TIMER_ID			TIMER_0_ID
+#define MOTOR_PWM_PRESCALER			F_CPU_8
+/* 256 counts at F_CPU/8: 3.9 kHz PWM, the ramp runs from the overflow call back */
+#define MOTOR_PWM_PERIOD_US			256
+
+/*
+ * Speed profile of a door movement: soft start, cruise, soft stop. The ramps follow the
+ * S-curve table in dc_motor.c (MOTOR_RAMP_STEPS entries), the times are rounded down to
+ * whole PWM periods per step. The travel time includes the two ramps and must end before
+ * the door phase of Door_tasksCTRL does, the phase itself does not change.
+ */
+#define MOTOR_CRUISE_DUTY			255		/* 0-255 */
+#define MOTOR_ACCELERATION_TIME_MS	800
+#define MOTOR_DECELERATION_TIME_MS	800
+#define MOTOR_TRAVEL_TIME_MS		12000
+#define MOTOR_RAMP_STEPS			32
+/* Step of the ramp table kept by DcMotor_slowDown (15% of the cruise duty) */
+#define MOTOR_CREEP_STEP			7
+
+#define MOTOR_ACCELERATION_STEP_PERIODS	((MOTOR_ACCELERATION_TIME_MS * 1000UL) / (MOTOR_RAMP_STEPS * MOTOR_PWM_PERIOD_US))
+#define MOTOR_DECELERATION_STEP_PERIODS	((MOTOR_DECELERATION_TIME_MS * 1000UL) / (MOTOR_RAMP_STEPS * MOTOR_PWM_PERIOD_US))
+#define MOTOR_CRUISE_PERIODS			(((MOTOR_TRAVEL_TIME_MS - MOTOR_ACCELERATION_TIME_MS - MOTOR_DECELERATION_TIME_MS) * 1000UL) / MOTOR_PWM_PERIOD_US)
+
+#if ((MOTOR_ACCELERATION_STEP_PERIODS == 0) || (MOTOR_DECELERATION_STEP_PERIODS == 0))
+#error "The motor ramps are shorter than one PWM period per step"
+#endif
+
+#if (MOTOR_TRAVEL_TIME_MS < (MOTOR_ACCELERATION_TIME_MS + MOTOR_DECELERATION_TIME_MS))
+#error "The motor travel time must include the acceleration and the deceleration"
+#endif
+
+#if (MOTOR_CRUISE_PERIODS > 0xFFFF)
+#error "The motor cruise time does not fit the 16-bit period counter"
+#endif
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	STOP,CW,ACW
+}DcMotor_State;
+
+typedef enum
+{
+	MOTOR_IDLE,MOTOR_ACCELERATING,MOTOR_CRUISING,MOTOR_DECELERATING
+}DcMotor_RampState;
+
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description :
+ * The Function responsible for setup the direction for the two motor pins and the enable pin through the GPIO driver.
+ * Start the PWM timer with a zero duty and stop the DC-Motor at the beginning.
+ */
+
+void DcMotor_init(void);
+
+/*
+ * Description:
+ * The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor based on the state input state value.
+ * The change is immediate (full cruise duty or stopped), any movement in progress is cancelled.
+ * Both H-bridge inputs change in one write, there is no intermediate state between two pin writes.
+ */
+
+void DcMotor_Rotate(DcMotor_State state);
+
+/*
+ * Description:
+ * The function responsible for one door movement in the required direction: soft start, cruise and
+ * soft stop, MOTOR_TRAVEL_TIME_MS in total. It returns at once, the PWM call back runs the profile
+ * and stops the motor at the end. STOP starts the soft stop of a movement in progress.
+ */
+
+void DcMotor_move(DcMotor_State state);
+
+/*
+ * Description:
+ * The function responsible for a soft start in the required direction, the motor then cruises
+ * until DcMotor_move(STOP), DcMotor_slowDown or DcMotor_Rotate(STOP) (movements ended by a sensor).
+ * STOP stops the motor at once.
+ */
+
+void DcMotor_run(DcMotor_State state);
+
+/*
+ * Description:
+ * The function responsible for decelerating a movement in progress to the MOTOR_CREEP_STEP duty
+ * and keeping it there, so the final approach to an end stop is slow.
+ */
+
+void DcMotor_slowDown(void);
+
+/*
+ * Description:
+ * The function responsible for returning the duty applied to the motor (0-255).
+ */
+
+uint8 DcMotor_getDuty(void);
+
+/*
+ * Description:
+ * The function responsible for returning the phase of the speed profile (MOTOR_IDLE once stopped).
+ */
+
+DcMotor_RampState DcMotor_getRampState(void);
+
+#endif /* DC_MOTOR_H_ */
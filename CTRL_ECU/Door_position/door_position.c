@@ -0,0 +1,259 @@
+/******************************************************************************
+ *
+ * Module: Door position
+ *
+ * File Name: door_position.c
+ *
+ * Description: Source file for the door position feedback (end stops and encoder
+ * 				on the external interrupts) that ends the door movements
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "door_position.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#if (DOOR_SLOWDOWN_COUNTS >= DOOR_TRAVEL_COUNTS)
+#error "The door slows down before it starts"
+#endif
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+/* encoder counts from the closed end stop, valid once g_referenced is TRUE */
+static volatile sint16 g_position = 0;
+static volatile boolean g_referenced = FALSE;
+static volatile boolean g_slowingDown = FALSE;
+static volatile DOOR_TargetType g_target = DOOR_CLOSED;
+static volatile DOOR_StateType g_state = DOOR_STOPPED;
+
+/*------------------------------------------------------------------------------
+ *                      Functions Prototypes(Private)                          *
+-------------------------------------------------------------------------------*/
+static void DOOR_endMovement(DOOR_StateType state);
+
+/*-------------------------------------------------------------------------------
+ *                       Interrupt Service Routines                      		 *
+--------------------------------------------------------------------------------*/
+/* Encoder channel A: one count, slow down near the end stop */
+ISR(INT0_vect)
+{
+	sint16 remaining;
+
+	if(GPIO_STATIC_READ_PIN(DOOR_ENCODER_B_PORT, DOOR_ENCODER_B_PIN_ID) == LOGIC_HIGH)
+	{
+		g_position++;
+	}
+	else
+	{
+		g_position--;
+	}
+
+	if((g_state != DOOR_MOVING) || (g_referenced == FALSE))
+	{
+		return;
+	}
+
+	remaining = (g_target == DOOR_OPEN) ? (DOOR_TRAVEL_COUNTS - g_position) : g_position;
+	if(remaining <= -DOOR_OVERTRAVEL_COUNTS)
+	{
+		/* far past the end stop without its interrupt */
+		DOOR_endMovement(DOOR_STOPPED);
+	}
+	else if((remaining <= DOOR_SLOWDOWN_COUNTS) && (g_slowingDown == FALSE))
+	{
+		g_slowingDown = TRUE;
+		DcMotor_slowDown();
+	}
+}
+
+/* Open end stop */
+ISR(INT1_vect)
+{
+	g_position = DOOR_TRAVEL_COUNTS;
+	g_referenced = TRUE;
+	if((g_state == DOOR_MOVING) && (g_target == DOOR_OPEN))
+	{
+		DOOR_endMovement(DOOR_AT_TARGET);
+	}
+}
+
+/* Closed end stop */
+ISR(INT2_vect)
+{
+	g_position = 0;
+	g_referenced = TRUE;
+	if((g_state == DOOR_MOVING) && (g_target == DOOR_CLOSED))
+	{
+		DOOR_endMovement(DOOR_AT_TARGET);
+	}
+}
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+static void DOOR_endMovement(DOOR_StateType state)
+{
+	DcMotor_Rotate(STOP);
+	g_state = state;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_init
+ *
+ * [Description]:  Function to set up the sensor pins and the external interrupts and
+ * 					take the position from the end stops (the position is unknown until
+ * 					an end stop is reached when the door is between them)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void DOOR_init(void)
+{
+	GPIO_STATIC_SETUP_PIN_DIRECTION(DOOR_ENCODER_A_PORT, DOOR_ENCODER_A_PIN_ID, PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(DOOR_ENCODER_B_PORT, DOOR_ENCODER_B_PIN_ID, PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(DOOR_OPEN_SWITCH_PORT, DOOR_OPEN_SWITCH_PIN_ID, PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(DOOR_CLOSED_SWITCH_PORT, DOOR_CLOSED_SWITCH_PIN_ID, PIN_INPUT);
+	/* internal pull-ups of the end stops */
+	GPIO_STATIC_WRITE_PIN(DOOR_OPEN_SWITCH_PORT, DOOR_OPEN_SWITCH_PIN_ID, LOGIC_HIGH);
+	GPIO_STATIC_WRITE_PIN(DOOR_CLOSED_SWITCH_PORT, DOOR_CLOSED_SWITCH_PIN_ID, LOGIC_HIGH);
+
+	if(GPIO_STATIC_READ_PIN(DOOR_CLOSED_SWITCH_PORT, DOOR_CLOSED_SWITCH_PIN_ID) == LOGIC_LOW)
+	{
+		g_position = 0;
+		g_referenced = TRUE;
+	}
+	else if(GPIO_STATIC_READ_PIN(DOOR_OPEN_SWITCH_PORT, DOOR_OPEN_SWITCH_PIN_ID) == LOGIC_LOW)
+	{
+		g_position = DOOR_TRAVEL_COUNTS;
+		g_referenced = TRUE;
+	}
+
+	/* INT0 rising edge, INT1 falling edge, INT2 falling edge (ISC2 = 0) */
+	MCUCR = (MCUCR & 0xF0) | (1<<ISC00) | (1<<ISC01) | (1<<ISC11);
+	CLEAR_BIT(MCUCSR, ISC2);
+	/* the flags set while the edges were configured are not events */
+	GIFR = (1<<INTF0) | (1<<INTF1) | (1<<INTF2);
+	GICR |= (1<<INT0) | (1<<INT1) | (1<<INT2);
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_move
+ *
+ * [Description]:  Function to start the movement to an end stop, the interrupts stop the
+ * 					motor there. The motor slows down DOOR_SLOWDOWN_COUNTS before the end stop,
+ * 					or runs at the creep speed all the way while the position is unknown.
+ *
+ * [Args]:        target: DOOR_OPEN or DOOR_CLOSED
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void DOOR_move(DOOR_TargetType target)
+{
+	uint8 sreg = SREG;
+	uint8 switch_level;
+
+	if(target == DOOR_OPEN)
+	{
+		switch_level = GPIO_STATIC_READ_PIN(DOOR_OPEN_SWITCH_PORT, DOOR_OPEN_SWITCH_PIN_ID);
+	}
+	else
+	{
+		switch_level = GPIO_STATIC_READ_PIN(DOOR_CLOSED_SWITCH_PORT, DOOR_CLOSED_SWITCH_PIN_ID);
+	}
+
+	cli();
+	g_target = target;
+	if(switch_level == LOGIC_LOW)
+	{
+		/* already there, the end stop will not see an edge */
+		g_state = DOOR_AT_TARGET;
+	}
+	else
+	{
+		g_state = DOOR_MOVING;
+		g_slowingDown = FALSE;
+		DcMotor_run((target == DOOR_OPEN) ? DOOR_OPENING_DIRECTION : DOOR_CLOSING_DIRECTION);
+		if(g_referenced == FALSE)
+		{
+			/* no position for the slow down: look for the end stop at the creep speed */
+			g_slowingDown = TRUE;
+			DcMotor_slowDown();
+		}
+	}
+	SREG = sreg;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_stop
+ *
+ * [Description]:  Function to stop the door at once (fault guard of a movement that
+ * 					did not reach its end stop in time)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void DOOR_stop(void)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	if(g_state == DOOR_MOVING)
+	{
+		DOOR_endMovement(DOOR_STOPPED);
+	}
+	SREG = sreg;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_getState
+ *
+ * [Description]:  Function to get the state of the last movement
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      one of DOOR_StateType
+ *
+ ----------------------------------------------------------------------------------*/
+DOOR_StateType DOOR_getState(void)
+{
+	return g_state;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_getOpenPercent
+ *
+ * [Description]:  Function to get how much the door is open
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      0 (closed) to 100 (open)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 DOOR_getOpenPercent(void)
+{
+	sint16 position;
+	uint8 sreg = SREG;
+
+	/* 16-bit value shared with the encoder interrupt */
+	cli();
+	position = g_position;
+	SREG = sreg;
+
+	if(position <= 0)
+	{
+		return 0;
+	}
+	if(position >= DOOR_TRAVEL_COUNTS)
+	{
+		return 100;
+	}
+	return (uint8)(((uint32)position * 100) / DOOR_TRAVEL_COUNTS);
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ *
+ * Module: Door position
+ *
+ * File Name: door_position.h
+ *
+ * Description: Header file for the door position feedback (end stops and encoder
+ * 				on the external interrupts) that ends the door movements
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef DOOR_POSITION_H_
+#define DOOR_POSITION_H_
+
+#include "std_types.h"
+#include "gpio.h"
+#include "dc_motor.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+/*
+ * Encoder on the door motor: channel A on INT0 (rising edge), channel B read in the
+ * interrupt gives the direction (high while the door opens).
+ */
+#define DOOR_ENCODER_A_PORT				PORTD_ID
+#define DOOR_ENCODER_A_PIN_ID			PIN2_ID
+#define DOOR_ENCODER_B_PORT				PORTD_ID
+#define DOOR_ENCODER_B_PIN_ID			PIN4_ID
+
+/* End stops, active low with the internal pull-ups: open on INT1, closed on INT2 */
+#define DOOR_OPEN_SWITCH_PORT			PORTD_ID
+#define DOOR_OPEN_SWITCH_PIN_ID			PIN3_ID
+#define DOOR_CLOSED_SWITCH_PORT			PORTB_ID
+#define DOOR_CLOSED_SWITCH_PIN_ID		PIN2_ID
+
+/* Motor direction of every movement */
+#define DOOR_OPENING_DIRECTION			CW
+#define DOOR_CLOSING_DIRECTION			ACW
+
+/* Encoder counts from the closed end stop to the open one */
+#define DOOR_TRAVEL_COUNTS				600
+/* The motor slows down to the creep speed this far from the end stop */
+#define DOOR_SLOWDOWN_COUNTS			60
+/* Counts past the end stop without its interrupt: the switch is broken, stop the door */
+#define DOOR_OVERTRAVEL_COUNTS			30
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum
+{
+	DOOR_CLOSED,DOOR_OPEN
+}DOOR_TargetType;
+
+/*
+ * DOOR_STOPPED: no movement, or a movement ended before its end stop (DOOR_stop, broken switch)
+ */
+typedef enum
+{
+	DOOR_STOPPED,DOOR_MOVING,DOOR_AT_TARGET
+}DOOR_StateType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_init
+ *
+ * [Description]:  Function to set up the sensor pins and the external interrupts and
+ * 					take the position from the end stops (the position is unknown until
+ * 					an end stop is reached when the door is between them)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void DOOR_init(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_move
+ *
+ * [Description]:  Function to start the movement to an end stop, the interrupts stop the
+ * 					motor there. The motor slows down DOOR_SLOWDOWN_COUNTS before the end stop,
+ * 					or runs at the creep speed all the way while the position is unknown.
+ *
+ * [Args]:        target: DOOR_OPEN or DOOR_CLOSED
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void DOOR_move(DOOR_TargetType target);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_stop
+ *
+ * [Description]:  Function to stop the door at once (fault guard of a movement that
+ * 					did not reach its end stop in time)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void DOOR_stop(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_getState
+ *
+ * [Description]:  Function to get the state of the last movement
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      one of DOOR_StateType
+ *
+ ----------------------------------------------------------------------------------*/
+DOOR_StateType DOOR_getState(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: DOOR_getOpenPercent
+ *
+ * [Description]:  Function to get how much the door is open
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      0 (closed) to 100 (open)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 DOOR_getOpenPercent(void);
+
+#endif /* DOOR_POSITION_H_ */
@@ -1,84 +1,323 @@
- /******************************************************************************
- *
- * Module: External EEPROM
- *
- * File Name: external_eeprom.c
- *
- * Description: Source file for the External EEPROM Memory
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-#include "external_eeprom.h"
-#include "twi.h"
-
-/*******************************************************************************/
-
-uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
-{
-	/* Send the Start Bit */
-    TWI_start();
-    if (TWI_getStatus() != TWI_START)
-        return ERROR;
-		
-    /* Send the device address, we need to get A8 A9 A10 address bits from the
-     * memory location address and R/W=0 (write) */
-    TWI_writeByte((uint8)(0xA0 | ((u16addr & 0x0700)>>7)));
-    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
-        return ERROR; 
-		 
-    /* Send the required memory location address */
-    TWI_writeByte((uint8)(u16addr));
-    if (TWI_getStatus() != TWI_MT_DATA_ACK)
-        return ERROR;
-		
-    /* write byte to eeprom */
-    TWI_writeByte(u8data);
-    if (TWI_getStatus() != TWI_MT_DATA_ACK)
-        return ERROR;
-
-    /* Send the Stop Bit */
-    TWI_stop();
-	
-    return SUCCESS;
-}
-
-uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
-{
-	/* Send the Start Bit */
-    TWI_start();
-    if (TWI_getStatus() != TWI_START)
-        return ERROR;
-		
-    /* Send the device address, we need to get A8 A9 A10 address bits from the
-     * memory location address and R/W=0 (write) */
-    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7)));
-    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
-        return ERROR;
-		
-    /* Send the required memory location address */
-    TWI_writeByte((uint8)(u16addr));
-    if (TWI_getStatus() != TWI_MT_DATA_ACK)
-        return ERROR;
-		
-    /* Send the Repeated Start Bit */
-    TWI_start();
-    if (TWI_getStatus() != TWI_REP_START)
-        return ERROR;
-		
-    /* Send the device address, we need to get A8 A9 A10 address bits from the
-     * memory location address and R/W=1 (Read) */
-    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7) | 1));
-    if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
-        return ERROR;
-
-    /* Read Byte from Memory without send ACK */
-    *u8data = TWI_readByteWithNACK();
-    if (TWI_getStatus() != TWI_MR_DATA_NACK)
-        return ERROR;
-
-    /* Send the Stop Bit */
-    TWI_stop();
-
-    return SUCCESS;
-}
+ /******************************************************************************
+ *
+ * Module: External EEPROM
+ *
+ * File Name: external_eeprom.c
+ *
+ * Description: Source file for the External EEPROM Memory
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+#include "external_eeprom.h"
+#include "twi.h"
+
+/*******************************************************************************/
+
+uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
+{
+    uint8 status = ERROR;
+
+	/* Send the Start Bit */
+    TWI_start();
+    if (TWI_getStatus() != TWI_START)
+        goto stop;
+		
+    /* Send the device address, we need to get A8 A9 A10 address bits from the
+     * memory location address and R/W=0 (write) */
+    TWI_writeByte((uint8)(0xA0 | ((u16addr & 0x0700)>>7)));
+    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
+        goto stop;
+		 
+    /* Send the required memory location address */
+    TWI_writeByte((uint8)(u16addr));
+    if (TWI_getStatus() != TWI_MT_DATA_ACK)
+        goto stop;
+		
+    /* write byte to eeprom */
+    TWI_writeByte(u8data);
+    if (TWI_getStatus() != TWI_MT_DATA_ACK)
+        goto stop;
+
+    status = SUCCESS;
+
+stop:
+    /* Send the Stop Bit, also after an error so the bus is released */
+    TWI_stop();
+	
+    return status;
+}
+
+uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
+{
+    uint8 status = ERROR;
+
+	/* Send the Start Bit */
+    TWI_start();
+    if (TWI_getStatus() != TWI_START)
+        goto stop;
+		
+    /* Send the device address, we need to get A8 A9 A10 address bits from the
+     * memory location address and R/W=0 (write) */
+    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7)));
+    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
+        goto stop;
+		
+    /* Send the required memory location address */
+    TWI_writeByte((uint8)(u16addr));
+    if (TWI_getStatus() != TWI_MT_DATA_ACK)
+        goto stop;
+		
+    /* Send the Repeated Start Bit */
+    TWI_start();
+    if (TWI_getStatus() != TWI_REP_START)
+        goto stop;
+		
+    /* Send the device address, we need to get A8 A9 A10 address bits from the
+     * memory location address and R/W=1 (Read) */
+    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7) | 1));
+    if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
+        goto stop;
+
+    /* Read Byte from Memory without send ACK */
+    *u8data = TWI_readByteWithNACK();
+    if (TWI_getStatus() != TWI_MR_DATA_NACK)
+        goto stop;
+
+    status = SUCCESS;
+
+stop:
+    /* Send the Stop Bit, also after an error so the bus is released */
+    TWI_stop();
+
+    return status;
+}
+
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 u16len)
+{
+    uint8 status;
+
+    if (u16len == 0)
+        return SUCCESS;
+
+    status = EEPROM_readBegin(u16addr);
+    if (status == SUCCESS)
+        status = EEPROM_readContinue(data, u16len, TRUE);
+
+    /* Send the Stop Bit, also after an error so the bus is released */
+    EEPROM_readEnd();
+
+    return status;
+}
+
+uint8 EEPROM_readBegin(uint16 u16addr)
+{
+	/* Send the Start Bit */
+    TWI_start();
+    if (TWI_getStatus() != TWI_START)
+        return ERROR;
+
+    /* Send the device address with the A8 A9 A10 bits and R/W=0 (write) */
+    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7)));
+    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
+        return ERROR;
+
+    /* Send the required memory location address */
+    TWI_writeByte((uint8)(u16addr));
+    if (TWI_getStatus() != TWI_MT_DATA_ACK)
+        return ERROR;
+
+    /* Send the Repeated Start Bit */
+    TWI_start();
+    if (TWI_getStatus() != TWI_REP_START)
+        return ERROR;
+
+    /* Send the device address with the A8 A9 A10 bits and R/W=1 (Read) */
+    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7) | 1));
+    if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
+        return ERROR;
+
+    return SUCCESS;
+}
+
+uint8 EEPROM_readContinue(uint8 *data, uint16 u16len, boolean last)
+{
+    uint16 i;
+
+    /* The memory auto-increments its address counter, ACK every byte except the last one */
+    for (i = 0; i < u16len; i++)
+    {
+        if (last && (i == (u16len - 1)))
+        {
+            data[i] = TWI_readByteWithNACK();
+            if (TWI_getStatus() != TWI_MR_DATA_NACK)
+                return ERROR;
+        }
+        else
+        {
+            data[i] = TWI_readByteWithACK();
+            if (TWI_getStatus() != TWI_MR_DATA_ACK)
+                return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+void EEPROM_readEnd(void)
+{
+    /* Send the Stop Bit */
+    TWI_stop();
+}
+
+uint8 EEPROM_writePage(uint16 u16addr, const uint8 *data, uint8 u8len)
+{
+    uint8 i;
+    uint8 status = ERROR;
+
+    /* The memory wraps inside the page, so a write crossing the page boundary would corrupt it */
+    if ((u8len == 0) || (u8len > EEPROM_PAGE_SIZE) ||
+        (((u16addr % EEPROM_PAGE_SIZE) + u8len) > EEPROM_PAGE_SIZE))
+        return ERROR;
+
+	/* Send the Start Bit */
+    TWI_start();
+    if (TWI_getStatus() != TWI_START)
+        goto stop;
+
+    /* Send the device address with the A8 A9 A10 bits and R/W=0 (write) */
+    TWI_writeByte((uint8)(0xA0 | ((u16addr & 0x0700)>>7)));
+    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
+        goto stop;
+
+    /* Send the required memory location address */
+    TWI_writeByte((uint8)(u16addr));
+    if (TWI_getStatus() != TWI_MT_DATA_ACK)
+        goto stop;
+
+    /* Fill the page buffer of the memory */
+    for (i = 0; i < u8len; i++)
+    {
+        TWI_writeByte(data[i]);
+        if (TWI_getStatus() != TWI_MT_DATA_ACK)
+            goto stop;
+    }
+
+    status = SUCCESS;
+
+stop:
+    /* Send the Stop Bit, the memory starts its internal write cycle now. It is sent after
+     * an error as well so the bus is released, the bytes received until then may still
+     * be written, so the write cycle is waited for in both cases */
+    TWI_stop();
+
+    if (EEPROM_waitReady() == ERROR)
+        return ERROR;
+
+    return status;
+}
+
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 u16len)
+{
+    uint8 chunk;
+
+    while (u16len > 0)
+    {
+        /* Never let one transaction cross a page boundary */
+        chunk = EEPROM_PAGE_SIZE - (u16addr % EEPROM_PAGE_SIZE);
+        if (chunk > u16len)
+            chunk = (uint8)u16len;
+
+        if (EEPROM_writePage(u16addr, data, chunk) == ERROR)
+            return ERROR;
+
+        u16addr += chunk;
+        data += chunk;
+        u16len -= chunk;
+    }
+
+    return SUCCESS;
+}
+
+uint8 EEPROM_updateBlock(uint16 u16addr, const uint8 *data, uint16 u16len, EEPROM_UpdateReportType *report)
+{
+    uint8 current[EEPROM_PAGE_SIZE];
+    uint8 chunk, first, last, i;
+
+    while (u16len > 0)
+    {
+        chunk = EEPROM_PAGE_SIZE - (u16addr % EEPROM_PAGE_SIZE);
+        if (chunk > u16len)
+            chunk = (uint8)u16len;
+
+        if (EEPROM_readBlock(u16addr, current, chunk) == ERROR)
+            return ERROR;
+
+        /* find the first and the last changed byte of this page */
+        first = chunk;
+        last = 0;
+        for (i = 0; i < chunk; i++)
+        {
+            if (current[i] != data[i])
+            {
+                if (first == chunk)
+                    first = i;
+                last = i;
+            }
+        }
+
+        if (first == chunk)
+        {
+            if (report != NULL_PTR)
+            {
+                report->bytesSkipped += chunk;
+                report->pagesSkipped++;
+            }
+        }
+        else
+        {
+            if (EEPROM_writePage(u16addr + first, &data[first], (last - first) + 1) == ERROR)
+                return ERROR;
+
+            if (report != NULL_PTR)
+            {
+                report->bytesWritten += (last - first) + 1;
+                report->bytesSkipped += chunk - ((last - first) + 1);
+                report->pagesWritten++;
+            }
+        }
+
+        u16addr += chunk;
+        data += chunk;
+        u16len -= chunk;
+    }
+
+    return SUCCESS;
+}
+
+uint8 EEPROM_waitReady(void)
+{
+    uint8 polls;
+
+    /* The memory does not acknowledge its address while the write cycle is in progress */
+    for (polls = 0; polls < EEPROM_WRITE_CYCLE_POLLS; polls++)
+    {
+        TWI_start();
+        if (TWI_getStatus() != TWI_START)
+        {
+            TWI_stop();
+            return ERROR;
+        }
+
+        TWI_writeByte(0xA0);
+        if (TWI_getStatus() == TWI_MT_SLA_W_ACK)
+        {
+            TWI_stop();
+            return SUCCESS;
+        }
+
+        TWI_stop();
+    }
+
+    return ERROR;
+}
@@ -1,31 +1,94 @@
- /******************************************************************************
- *
- * Module: External EEPROM
- *
- * File Name: external_eeprom.h
- *
- * Description: Header file for the External EEPROM Memory
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-
-
-#ifndef EXTERNAL_EEPROM_H_
-#define EXTERNAL_EEPROM_H_
-
-#include "std_types.h"
-
-/*******************************************************************************
- *                      Preprocessor Macros                                    *
- *******************************************************************************/
-#define ERROR 0
-#define SUCCESS 1
-
-/*******************************************************************************
- *                      Functions Prototypes                                   *
- *******************************************************************************/
-uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
-uint8 EEPROM_readByte(uint16 u16addr,uint8 *u8data);
- 
-#endif /* EXTERNAL_EEPROM_H_ */
+ /******************************************************************************
+ *
+ * Module: External EEPROM
+ *
+ * File Name: external_eeprom.h
+ *
+ * Description: Header file for the External EEPROM Memory
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+
+#ifndef EXTERNAL_EEPROM_H_
+#define EXTERNAL_EEPROM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+#define ERROR 0
+#define SUCCESS 1
+
+/* 24C16: 2 KBytes organised as 8 blocks of 256 bytes, written in 16-byte pages */
+#define EEPROM_SIZE                 2048
+#define EEPROM_PAGE_SIZE            16
+
+/* Number of acknowledge polls before giving up on an internal write cycle */
+#define EEPROM_WRITE_CYCLE_POLLS    200
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+/* Counters filled by EEPROM_updateBlock, every call adds to them */
+typedef struct
+{
+	uint16 bytesWritten;
+	uint16 bytesSkipped;
+	uint16 pagesWritten;
+	uint16 pagesSkipped;
+}EEPROM_UpdateReportType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
+uint8 EEPROM_readByte(uint16 u16addr,uint8 *u8data);
+
+/*
+ * Description :
+ * Read u16len consecutive bytes starting at u16addr in one sequential read transaction.
+ */
+uint8 EEPROM_readBlock(uint16 u16addr,uint8 *data,uint16 u16len);
+
+/*
+ * Description :
+ * Sequential read in steps, for a range too long for one buffer: EEPROM_readBegin addresses
+ * u16addr, every EEPROM_readContinue reads the next u16len bytes (last = TRUE for the final
+ * part, its last byte is not acknowledged) and EEPROM_readEnd sends the stop. EEPROM_readEnd
+ * must be called after an error as well, so the bus is released.
+ */
+uint8 EEPROM_readBegin(uint16 u16addr);
+uint8 EEPROM_readContinue(uint8 *data,uint16 u16len,boolean last);
+void EEPROM_readEnd(void);
+
+/*
+ * Description :
+ * Write up to EEPROM_PAGE_SIZE bytes in one page write transaction and wait for the
+ * internal write cycle to finish. The range must not cross a page boundary.
+ */
+uint8 EEPROM_writePage(uint16 u16addr,const uint8 *data,uint8 u8len);
+
+/*
+ * Description :
+ * Write u16len bytes starting at u16addr, split into page write transactions.
+ */
+uint8 EEPROM_writeBlock(uint16 u16addr,const uint8 *data,uint16 u16len);
+
+/*
+ * Description :
+ * Read-compare-write: read the target range page by page and write only the bytes that
+ * differ (one page write per changed page, covering the first to the last changed byte).
+ * Unchanged pages cost no write cycle at all. report may be NULL_PTR.
+ */
+uint8 EEPROM_updateBlock(uint16 u16addr,const uint8 *data,uint16 u16len,EEPROM_UpdateReportType *report);
+
+/*
+ * Description :
+ * Acknowledge polling: wait until the memory finishes its internal write cycle.
+ */
+uint8 EEPROM_waitReady(void);
+ 
+#endif /* EXTERNAL_EEPROM_H_ */
@@ -0,0 +1,233 @@
+/******************************************************************************
+ *
+ * Module: Host simulation
+ *
+ * File Name: current_bench.c
+ *
+ * Description: Native Linux test of the motor current monitor: the motor driver, the
+ * 				ADC driver and the monitor run on the motor current model, a blocked door
+ * 				and a short between the motor leads must stop the motor, a normal movement must not
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include "current_monitor.h"
+#include "motor_current_model.h"
+#include "timer_host.h"
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+/* model integration step */
+#define BENCH_STEP_US				8.0
+/* free running conversion: 13 ADC clocks at F_CPU/128 */
+#define BENCH_ADC_PERIOD_US			(13.0 * 128 * 1e6 / F_CPU)
+#define BENCH_ADC_RUNNING			((1<<ADEN) | (1<<ADATE) | (1<<ADIE))
+/* a fault must stop the motor within these times */
+#define BENCH_STALL_LIMIT_MS		250.0
+#define BENCH_OVERCURRENT_LIMIT_MS	5.0
+
+void ADC_vect(void);
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static float64 g_nowUs = 0;
+static float64 g_nextAdcUs = 0;
+static float64 g_nextPwmUs = 0;
+static uint32 g_failures = 0;
+static uint32 g_callBacks = 0;
+static CURRENT_FaultType g_callBackFault = CURRENT_NO_FAULT;
+/* time the motor was stopped by the monitor */
+static float64 g_tripUs = 0;
+static uint16 g_peakAverage = 0;
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+static void BENCH_faultCallBack(CURRENT_FaultType fault)
+{
+	g_callBacks++;
+	g_callBackFault = fault;
+	g_tripUs = g_nowUs;
+}
+
+/* H-bridge inputs and PWM duty as the motor sees them */
+static void BENCH_applyDrive(void)
+{
+	uint8 pins = PORTC & MOTOR_PINS_MASK;
+	sint8 direction = 0;
+
+	if (pins == MOTOR_CW_PINS)
+	{
+		direction = 1;
+	}
+	else if (pins == MOTOR_ACW_PINS)
+	{
+		direction = -1;
+	}
+	MOTOR_MODEL_setDrive(direction, (uint8)HOST_TIMER_getCompareValue(MOTOR_PWM_TIMER_ID));
+}
+
+/* run the model, the PWM overflow and the ADC interrupts for ms milliseconds */
+static void BENCH_run(float64 ms)
+{
+	float64 end = g_nowUs + (ms * 1000.0);
+	uint16 average;
+
+	while (g_nowUs < end)
+	{
+		BENCH_applyDrive();
+		MOTOR_MODEL_step(BENCH_STEP_US);
+		g_nowUs += BENCH_STEP_US;
+
+		if (g_nowUs >= g_nextPwmUs)
+		{
+			g_nextPwmUs += MOTOR_PWM_PERIOD_US;
+			HOST_TIMER_event(MOTOR_PWM_TIMER_ID);
+		}
+		if (g_nowUs >= g_nextAdcUs)
+		{
+			g_nextAdcUs += BENCH_ADC_PERIOD_US;
+			if ((ADCSRA & BENCH_ADC_RUNNING) == BENCH_ADC_RUNNING)
+			{
+				ADC = MOTOR_MODEL_sample(g_nowUs);
+				ADC_vect();
+				average = CURRENT_getAverage();
+				if (average > g_peakAverage)
+				{
+					g_peakAverage = average;
+				}
+			}
+		}
+	}
+}
+
+/* motor at rest, monitor ready */
+static void BENCH_reset(void)
+{
+	DcMotor_Rotate(STOP);
+	MOTOR_MODEL_init(NULL_PTR);
+	BENCH_run(20);
+	CURRENT_clearFault();
+	g_callBacks = 0;
+	g_callBackFault = CURRENT_NO_FAULT;
+	g_peakAverage = 0;
+}
+
+static void BENCH_expectNoFault(const char *name)
+{
+	printf("%-36s peak %5.2f A  ", name, (float64)g_peakAverage / CURRENT_COUNTS_PER_AMPERE);
+	if ((CURRENT_getFault() != CURRENT_NO_FAULT) || (g_callBacks != 0))
+	{
+		printf("FAIL: fault %u\n", CURRENT_getFault());
+		g_failures++;
+		return;
+	}
+	printf("ok, no fault\n");
+}
+
+static void BENCH_expectFault(const char *name, CURRENT_FaultType fault, float64 faultUs, float64 limitMs)
+{
+	float64 latencyMs = (g_tripUs - faultUs) / 1000.0;
+
+	printf("%-36s peak %5.2f A  ", name, (float64)g_peakAverage / CURRENT_COUNTS_PER_AMPERE);
+	if ((CURRENT_getFault() != fault) || (g_callBacks != 1) || (g_callBackFault != fault))
+	{
+		printf("FAIL: fault %u (expected %u), %u call backs\n", CURRENT_getFault(), fault, g_callBacks);
+		g_failures++;
+		return;
+	}
+	if ((DcMotor_getDuty() != 0) || ((PORTC & MOTOR_PINS_MASK) != MOTOR_STOP_PINS))
+	{
+		printf("FAIL: the motor is still driven\n");
+		g_failures++;
+		return;
+	}
+	printf("%s after %.1f ms", (fault == CURRENT_STALL) ? "stall" : "overcurrent", latencyMs);
+	if (latencyMs > limitMs)
+	{
+		printf(" FAIL: limit %.1f ms\n", limitMs);
+		g_failures++;
+		return;
+	}
+	printf("\n");
+}
+
+int main(void)
+{
+	float64 faultUs;
+
+	DcMotor_init();
+	CURRENT_setCallBack(BENCH_faultCallBack);
+	CURRENT_init();
+	sei();
+
+	if (((ADMUX & 0x07) != CURRENT_SENSE_CHANNEL) || ((ADCSRA & BENCH_ADC_RUNNING) != BENCH_ADC_RUNNING))
+	{
+		printf("FAIL: the ADC is not converting the current sense in free running mode\n");
+		return 1;
+	}
+
+	/* a full door movement: soft start, cruise and soft stop */
+	BENCH_reset();
+	DcMotor_move(CW);
+	BENCH_run(MOTOR_TRAVEL_TIME_MS + 100);
+	BENCH_expectNoFault("normal movement");
+
+	/* full duty at once: the inrush is shorter than the stall time */
+	BENCH_reset();
+	DcMotor_Rotate(ACW);
+	BENCH_run(1000);
+	BENCH_expectNoFault("hard start");
+
+	/* creep speed towards the end stop */
+	BENCH_reset();
+	DcMotor_run(CW);
+	BENCH_run(1500);
+	DcMotor_slowDown();
+	BENCH_run(2000);
+	BENCH_expectNoFault("creep");
+
+	/* the door is blocked at cruise speed */
+	BENCH_reset();
+	DcMotor_run(CW);
+	BENCH_run(2000);
+	faultUs = g_nowUs;
+	MOTOR_MODEL_setJammed(TRUE);
+	BENCH_run(1000);
+	BENCH_expectFault("blocked at cruise speed", CURRENT_STALL, faultUs, BENCH_STALL_LIMIT_MS);
+
+	/* the door is blocked at the creep speed, the current is far below the cruise current */
+	BENCH_reset();
+	DcMotor_run(ACW);
+	BENCH_run(1500);
+	DcMotor_slowDown();
+	BENCH_run(1500);
+	faultUs = g_nowUs;
+	MOTOR_MODEL_setJammed(TRUE);
+	BENCH_run(1000);
+	BENCH_expectFault("blocked at creep speed", CURRENT_STALL, faultUs, BENCH_STALL_LIMIT_MS);
+
+	/* blocked before the start: the stall is found during the soft start */
+	BENCH_reset();
+	MOTOR_MODEL_setJammed(TRUE);
+	faultUs = g_nowUs;
+	DcMotor_run(CW);
+	BENCH_run(2000);
+	BENCH_expectFault("blocked at the start", CURRENT_STALL, faultUs, MOTOR_ACCELERATION_TIME_MS);
+
+	/* short between the motor leads at cruise speed */
+	BENCH_reset();
+	DcMotor_run(CW);
+	BENCH_run(2000);
+	faultUs = g_nowUs;
+	MOTOR_MODEL_setLeadShort(1.0);
+	BENCH_run(100);
+	BENCH_expectFault("short between the motor leads", CURRENT_OVERCURRENT, faultUs, BENCH_OVERCURRENT_LIMIT_MS);
+
+	printf("%u failures\n", g_failures);
+	return (g_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/******************************************************************************
+ *
+ * Module: 24C16 EEPROM model
+ *
+ * File Name: eeprom_24c16_model.c
+ *
+ * Description: Source file for the host model of the 24C16 I2C EEPROM, its memory
+ * 				array is an mmap'd image file that survives across simulated reboots
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "eeprom_24c16_model.h"
+#include "external_eeprom.h"
+#include "host_clock.h"
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+typedef enum
+{
+	MODEL_IDLE,MODEL_WORD_ADDRESS,MODEL_WRITE_DATA,MODEL_READ_DATA,MODEL_NOT_SELECTED
+}MODEL_PhaseType;
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static int g_fd = -1;
+static uint8 *g_memory = NULL_PTR;
+static EEPROM_MODEL_ConfigType g_config = {EEPROM_MODEL_WRITE_CYCLE_US, 0, 0, 0};
+static EEPROM_MODEL_StatisticsType g_statistics;
+
+static MODEL_PhaseType g_phase = MODEL_IDLE;
+static uint16 g_addressCounter = 0;
+static uint8 g_block = 0;
+/* page buffer: latched bytes of the page being written */
+static uint8 g_pageBuffer[EEPROM_MODEL_PAGE_SIZE];
+static uint16 g_latched = 0;
+static uint16 g_pageBase = 0;
+
+static uint64 g_busyUntilUs = 0;
+static boolean g_powerLost = FALSE;
+static uint32 g_bytesWritten = 0;
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+uint8 EEPROM_MODEL_open(const char *imagePath, const EEPROM_MODEL_ConfigType *Config_Ptr)
+{
+	struct stat info;
+	uint8 erased[EEPROM_MODEL_SIZE];
+
+	g_fd = open(imagePath, O_RDWR | O_CREAT, 0644);
+	if ((g_fd < 0) || (fstat(g_fd, &info) != 0))
+		return ERROR;
+
+	/* a new image is an erased device */
+	if (info.st_size != EEPROM_MODEL_SIZE)
+	{
+		memset(erased, 0xFF, sizeof(erased));
+		if ((ftruncate(g_fd, 0) != 0) || (pwrite(g_fd, erased, sizeof(erased), 0) != (ssize_t)sizeof(erased)))
+			return ERROR;
+	}
+
+	g_memory = mmap(NULL, EEPROM_MODEL_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, g_fd, 0);
+	if (g_memory == MAP_FAILED)
+	{
+		g_memory = NULL_PTR;
+		return ERROR;
+	}
+
+	memset(&g_statistics, 0, sizeof(g_statistics));
+	if (Config_Ptr != NULL_PTR)
+		g_config = *Config_Ptr;
+	EEPROM_MODEL_powerCycle();
+	return SUCCESS;
+}
+
+void EEPROM_MODEL_close(void)
+{
+	if (g_memory != NULL_PTR)
+	{
+		msync(g_memory, EEPROM_MODEL_SIZE, MS_SYNC);
+		munmap(g_memory, EEPROM_MODEL_SIZE);
+		g_memory = NULL_PTR;
+	}
+	if (g_fd >= 0)
+	{
+		close(g_fd);
+		g_fd = -1;
+	}
+}
+
+void EEPROM_MODEL_configure(const EEPROM_MODEL_ConfigType *Config_Ptr)
+{
+	g_config = *Config_Ptr;
+}
+
+void EEPROM_MODEL_powerCycle(void)
+{
+	g_phase = MODEL_IDLE;
+	g_latched = 0;
+	g_busyUntilUs = 0;
+	g_powerLost = FALSE;
+}
+
+boolean EEPROM_MODEL_isPowerLost(void)
+{
+	return g_powerLost;
+}
+
+uint8 *EEPROM_MODEL_memory(void)
+{
+	return g_memory;
+}
+
+void EEPROM_MODEL_getStatistics(EEPROM_MODEL_StatisticsType *statistics)
+{
+	*statistics = g_statistics;
+}
+
+void EEPROM_MODEL_busStart(void)
+{
+	/* a (repeated) start before the stop cancels a page write */
+	g_latched = 0;
+	g_phase = MODEL_IDLE;
+	g_statistics.transactions++;
+}
+
+/*
+ * Description :
+ * The stop condition starts the internal write cycle of the latched bytes.
+ */
+void EEPROM_MODEL_busStop(void)
+{
+	uint8 i, programmed = 0;
+
+	if ((g_phase == MODEL_WRITE_DATA) && (g_latched != 0) && !g_powerLost)
+	{
+		g_statistics.pageWrites++;
+		for (i = 0; i < EEPROM_MODEL_PAGE_SIZE; i++)
+		{
+			if (g_latched & (1 << i))
+			{
+				if ((g_config.powerFailAtPageWrite == 1) && (programmed == g_config.powerFailBytes))
+				{
+					g_powerLost = TRUE;
+					break;
+				}
+				g_memory[g_pageBase + i] = g_pageBuffer[i];
+				programmed++;
+			}
+		}
+		g_statistics.bytesProgrammed += programmed;
+		if (g_config.powerFailAtPageWrite != 0)
+		{
+			if (g_config.powerFailAtPageWrite == 1)
+				g_powerLost = TRUE;
+			g_config.powerFailAtPageWrite--;
+		}
+		g_busyUntilUs = HOST_CLOCK_nowUs() + g_config.writeCycleUs;
+	}
+	g_latched = 0;
+	g_phase = MODEL_IDLE;
+}
+
+boolean EEPROM_MODEL_busAddress(uint8 slaveAddress)
+{
+	if (g_powerLost || (g_memory == NULL_PTR) || ((slaveAddress & 0xF0) != EEPROM_MODEL_DEVICE_TYPE))
+	{
+		g_phase = MODEL_NOT_SELECTED;
+		return FALSE;
+	}
+
+	/* the device ignores its address during the internal write cycle */
+	if (HOST_CLOCK_nowUs() < g_busyUntilUs)
+	{
+		g_statistics.busyNacks++;
+		g_phase = MODEL_NOT_SELECTED;
+		return FALSE;
+	}
+
+	g_block = (slaveAddress >> 1) & 0x07;
+	if (slaveAddress & 0x01)
+	{
+		g_phase = MODEL_READ_DATA;
+	}
+	else
+	{
+		g_phase = MODEL_WORD_ADDRESS;
+	}
+	return TRUE;
+}
+
+boolean EEPROM_MODEL_busWrite(uint8 data)
+{
+	uint8 offset;
+
+	if ((g_phase != MODEL_WORD_ADDRESS) && (g_phase != MODEL_WRITE_DATA))
+		return FALSE;
+
+	g_bytesWritten++;
+	if ((g_config.nackEveryByte != 0) && ((g_bytesWritten % g_config.nackEveryByte) == 0))
+		return FALSE;
+
+	if (g_phase == MODEL_WORD_ADDRESS)
+	{
+		g_addressCounter = ((uint16)g_block << 8) | data;
+		g_pageBase = g_addressCounter & ~(EEPROM_MODEL_PAGE_SIZE - 1);
+		g_latched = 0;
+		g_phase = MODEL_WRITE_DATA;
+		return TRUE;
+	}
+
+	/* the address rolls over inside the page, later bytes overwrite the earlier ones */
+	offset = g_addressCounter & (EEPROM_MODEL_PAGE_SIZE - 1);
+	g_pageBuffer[offset] = data;
+	g_latched |= (1 << offset);
+	g_addressCounter = g_pageBase | ((offset + 1) & (EEPROM_MODEL_PAGE_SIZE - 1));
+	return TRUE;
+}
+
+uint8 EEPROM_MODEL_busRead(void)
+{
+	uint8 data;
+
+	if (g_phase != MODEL_READ_DATA)
+		return 0xFF;
+
+	/* sequential read: the counter rolls over the whole array */
+	data = g_memory[g_addressCounter];
+	g_addressCounter = (g_addressCounter + 1) % EEPROM_MODEL_SIZE;
+	g_statistics.bytesRead++;
+	return data;
+}
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *
+ * Module: 24C16 EEPROM model
+ *
+ * File Name: eeprom_24c16_model.h
+ *
+ * Description: Header file for the host model of the 24C16 I2C EEPROM, its memory
+ * 				array is an mmap'd image file that survives across simulated reboots
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef EEPROM_24C16_MODEL_H_
+#define EEPROM_24C16_MODEL_H_
+
+#include "std_types.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+#define EEPROM_MODEL_SIZE				2048
+#define EEPROM_MODEL_PAGE_SIZE			16
+/* device type identifier 1010 of the slave address */
+#define EEPROM_MODEL_DEVICE_TYPE		0xA0
+/* typical 24C16 write cycle time */
+#define EEPROM_MODEL_WRITE_CYCLE_US		5000
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: EEPROM_MODEL_ConfigType
+ *
+ * [Description]: Timing and fault injection of the model
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * writeCycleUs: internal write cycle time, the device NACKs its address until it ends
+	 */
+			uint32	writeCycleUs;
+	/*
+	 * powerFailAtPageWrite: the page write with this number (1 = the next one) is torn:
+	 * only powerFailBytes of its bytes are programmed and then the power is lost, 0 = off
+	 */
+			uint32	powerFailAtPageWrite;
+			uint8	powerFailBytes;
+	/*
+	 * nackEveryByte: NACK every Nth data byte written to the device (bus fault), 0 = off
+	 */
+			uint32	nackEveryByte;
+}EEPROM_MODEL_ConfigType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: EEPROM_MODEL_StatisticsType
+ *
+ * [Description]: Counters since the image was opened
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+			uint32	transactions;
+			uint32	pageWrites;
+			uint32	bytesProgrammed;
+			uint32	bytesRead;
+			uint32	busyNacks;
+}EEPROM_MODEL_StatisticsType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*
+ * Description :
+ * Map the image file (created erased, all 0xFF, if it does not exist) and apply the
+ * configuration. Config_Ptr may be NULL_PTR for the datasheet timing without faults.
+ */
+uint8 EEPROM_MODEL_open(const char *imagePath, const EEPROM_MODEL_ConfigType *Config_Ptr);
+
+/*
+ * Description :
+ * Flush and unmap the image file.
+ */
+void EEPROM_MODEL_close(void);
+
+/*
+ * Description :
+ * Change the timing/fault configuration of an open model.
+ */
+void EEPROM_MODEL_configure(const EEPROM_MODEL_ConfigType *Config_Ptr);
+
+/*
+ * Description :
+ * Simulated reboot: restore the power, drop the page buffer and any transaction in progress.
+ * The memory array keeps its contents.
+ */
+void EEPROM_MODEL_powerCycle(void);
+
+/*
+ * Description :
+ * TRUE after an injected power failure, until EEPROM_MODEL_powerCycle is called.
+ */
+boolean EEPROM_MODEL_isPowerLost(void);
+
+/*
+ * Description :
+ * Direct access to the memory array (not through the bus) for inspection.
+ */
+uint8 *EEPROM_MODEL_memory(void);
+
+void EEPROM_MODEL_getStatistics(EEPROM_MODEL_StatisticsType *statistics);
+
+/*
+ * Description :
+ * Bus side of the model, called by the host TWI backend. The address and write
+ * functions return TRUE when the device acknowledges.
+ */
+void EEPROM_MODEL_busStart(void);
+void EEPROM_MODEL_busStop(void);
+boolean EEPROM_MODEL_busAddress(uint8 slaveAddress);
+boolean EEPROM_MODEL_busWrite(uint8 data);
+uint8 EEPROM_MODEL_busRead(void);
+
+#endif /* EEPROM_24C16_MODEL_H_ */
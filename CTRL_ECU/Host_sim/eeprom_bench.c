@@ -0,0 +1,195 @@
+/******************************************************************************
+ *
+ * Module: Host simulation
+ *
+ * File Name: eeprom_bench.c
+ *
+ * Description: Native Linux benchmark of the CTRL ECU persistence (log storage,
+ * 				credential record, audit log) on the 24C16 model, including simulated
+ * 				power failures during the password save and bus faults
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "twi.h"
+#include "eeprom_24c16_model.h"
+#include "host_clock.h"
+#include "log_storage.h"
+#include "credential_storage.h"
+#include "audit_log.h"
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+#define BENCH_DEFAULT_IMAGE			"eeprom_24c16.img"
+#define BENCH_ITERATIONS			200
+#define BENCH_POWER_FAILURES		100
+/* NACK every Nth byte written, N = 1 up to one whole record transfer */
+#define BENCH_MAX_NACK_DISTANCE		(EEPROM_MODEL_PAGE_SIZE + 2)
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static uint32 g_uartBytes = 0;
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+/* the audit dump streams here instead of the UART */
+void UART_sendByte(const uint8 data)
+{
+	(void)data;
+	g_uartBytes++;
+}
+
+static void BENCH_boot(void)
+{
+	LOG_init();
+	AUDIT_init();
+}
+
+static void BENCH_report(const char *name, uint64 startUs, uint32 operations,
+						 const EEPROM_MODEL_StatisticsType *before)
+{
+	EEPROM_MODEL_StatisticsType after;
+	uint64 elapsedUs = HOST_CLOCK_nowUs() - startUs;
+
+	EEPROM_MODEL_getStatistics(&after);
+	printf("%-28s %6u ops %10.1f us/op %7.3f page writes/op %7.1f bytes programmed/op\n",
+		   name, operations, (double)elapsedUs / operations,
+		   (double)(after.pageWrites - before->pageWrites) / operations,
+		   (double)(after.bytesProgrammed - before->bytesProgrammed) / operations);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *image = (argc > 1) ? argv[1] : BENCH_DEFAULT_IMAGE;
+	/* same bus configuration as the CTRL ECU: 400 kHz */
+	TWI_ConfigType TWI_configuration = {TWI_Prescaler_1, 0x02, TWI_CONTROL_ECU_ADDRESS};
+	EEPROM_MODEL_ConfigType fault = {EEPROM_MODEL_WRITE_CYCLE_US, 0, 0, 0};
+	EEPROM_MODEL_StatisticsType before;
+	EEPROM_UpdateReportType report;
+	uint8 password[CREDENTIAL_LENGTH] = {1, 2, 3, 4, 5};
+	uint8 loaded[CREDENTIAL_LENGTH];
+	uint8 previous, counter;
+	uint64 start;
+	uint32 i, lost = 0, stuck = 0;
+
+	if (EEPROM_MODEL_open(image, NULL_PTR) == ERROR)
+	{
+		fprintf(stderr, "cannot map %s\n", image);
+		return 1;
+	}
+	TWI_init(&TWI_configuration);
+
+	EEPROM_MODEL_getStatistics(&before);
+	start = HOST_CLOCK_nowUs();
+	BENCH_boot();
+	printf("image %s: credential %s\n", image, (CREDENTIAL_load(loaded) == SUCCESS) ? "found" : "not set");
+	BENCH_report("boot scan", start, 1, &before);
+
+	EEPROM_MODEL_getStatistics(&before);
+	start = HOST_CLOCK_nowUs();
+	for (i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		password[0] = i % 10;
+		CREDENTIAL_save(password);
+	}
+	BENCH_report("password change", start, BENCH_ITERATIONS, &before);
+
+	EEPROM_MODEL_getStatistics(&before);
+	start = HOST_CLOCK_nowUs();
+	for (i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		CREDENTIAL_save(password);
+	}
+	BENCH_report("same password saved again", start, BENCH_ITERATIONS, &before);
+
+	EEPROM_MODEL_getStatistics(&before);
+	start = HOST_CLOCK_nowUs();
+	for (i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		counter = i % 4;
+		LOG_write(LOG_KEY_WRONG_ATTEMPTS, &counter, 1);
+	}
+	BENCH_report("counter update", start, BENCH_ITERATIONS, &before);
+
+	EEPROM_MODEL_getStatistics(&before);
+	start = HOST_CLOCK_nowUs();
+	for (i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		AUDIT_append(AUDIT_EVENT_WRONG_PASSWORD, AUDIT_DEFAULT_USER, i, (uint32)(HOST_CLOCK_nowUs() / 1000000));
+	}
+	BENCH_report("audit append", start, BENCH_ITERATIONS, &before);
+
+	EEPROM_MODEL_getStatistics(&before);
+	start = HOST_CLOCK_nowUs();
+	g_uartBytes = 0;
+	AUDIT_dump();
+	BENCH_report("audit dump", start, 1, &before);
+	printf("audit dump streamed %u bytes\n", g_uartBytes);
+
+	/* power failures in the middle of the password save, then a simulated reboot */
+	srand(1);
+	for (i = 0; i < BENCH_POWER_FAILURES; i++)
+	{
+		previous = password[0];
+		password[0] = (previous + 1) % 10;
+
+		fault.powerFailAtPageWrite = 1 + (rand() % 3);
+		fault.powerFailBytes = rand() % EEPROM_MODEL_PAGE_SIZE;
+		EEPROM_MODEL_configure(&fault);
+		CREDENTIAL_save(password);
+
+		EEPROM_MODEL_powerCycle();
+		BENCH_boot();
+		if ((CREDENTIAL_load(loaded) != SUCCESS) || ((loaded[0] != previous) && (loaded[0] != password[0])))
+		{
+			lost++;
+		}
+		password[0] = loaded[0];
+	}
+	fault.powerFailAtPageWrite = 0;
+	EEPROM_MODEL_configure(&fault);
+	printf("power failures during save: %u, password lost: %u\n", BENCH_POWER_FAILURES, lost);
+
+	/*
+	 * a NACK in the middle of a transfer fails it, after the fault is gone the next read
+	 * and write must succeed (the failed transfer must not keep the bus)
+	 */
+	for (i = 1; i <= BENCH_MAX_NACK_DISTANCE; i++)
+	{
+		password[0] = i % 10;
+
+		fault.nackEveryByte = i;
+		EEPROM_MODEL_configure(&fault);
+		if (i == 1)
+		{
+			/* the word address of the read is NACKed */
+			CREDENTIAL_load(loaded);
+		}
+		else
+		{
+			CREDENTIAL_save(password);
+		}
+
+		fault.nackEveryByte = 0;
+		EEPROM_MODEL_configure(&fault);
+		if ((CREDENTIAL_load(loaded) != SUCCESS) || (CREDENTIAL_save(password) != SUCCESS) ||
+			(CREDENTIAL_load(loaded) != SUCCESS) || (loaded[0] != password[0]))
+		{
+			stuck++;
+		}
+	}
+	printf("bus faults: %u, EEPROM access lost after the fault: %u\n", BENCH_MAX_NACK_DISTANCE, stuck);
+
+	LOG_getWriteReport(&report);
+	printf("log read-compare-write: %u bytes / %u pages written, %u bytes / %u pages skipped\n",
+		   report.bytesWritten, report.pagesWritten, report.bytesSkipped, report.pagesSkipped);
+
+	EEPROM_MODEL_close();
+	return ((lost == 0) && (stuck == 0)) ? 0 : 1;
+}
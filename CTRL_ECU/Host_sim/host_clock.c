@@ -0,0 +1,25 @@
+/******************************************************************************
+ *
+ * Module: Host clock
+ *
+ * File Name: host_clock.c
+ *
+ * Description: Source file for the simulated time base of the host simulation builds
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "host_clock.h"
+
+static uint64 g_nowUs = 0;
+
+uint64 HOST_CLOCK_nowUs(void)
+{
+	return g_nowUs;
+}
+
+void HOST_CLOCK_advanceUs(uint64 us)
+{
+	g_nowUs += us;
+}
@@ -0,0 +1,34 @@
+/******************************************************************************
+ *
+ * Module: Host clock
+ *
+ * File Name: host_clock.h
+ *
+ * Description: Header file for the simulated time base of the host simulation builds
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef HOST_CLOCK_H_
+#define HOST_CLOCK_H_
+
+#include "std_types.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*
+ * Description :
+ * Return the simulated time in microseconds. The time only moves when the drivers
+ * and device models advance it, so the results do not depend on the host speed.
+ */
+uint64 HOST_CLOCK_nowUs(void);
+
+/*
+ * Description :
+ * Advance the simulated time (used by the delay shim and the bus backends).
+ */
+void HOST_CLOCK_advanceUs(uint64 us);
+
+#endif /* HOST_CLOCK_H_ */
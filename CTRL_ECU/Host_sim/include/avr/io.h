@@ -0,0 +1,46 @@
+/******************************************************************************
+ *
+ * Module: Host simulation shims
+ *
+ * File Name: io.h
+ *
+ * Description: Stand-in for <avr/io.h> in the host simulation builds. The host
+ * 				backends replace the TWI and Timer drivers, the registers used by the
+ * 				other drivers (ports, SREG and ADC) are plain variables (io_host.c).
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+extern volatile unsigned char PORTA, DDRA, PINA;
+extern volatile unsigned char PORTB, DDRB, PINB;
+extern volatile unsigned char PORTC, DDRC, PINC;
+extern volatile unsigned char PORTD, DDRD, PIND;
+
+extern volatile unsigned char SREG;
+
+extern volatile unsigned char ADMUX, ADCSRA, SFIOR;
+extern volatile unsigned short ADC;
+
+/* ADMUX */
+#define REFS1		7
+#define REFS0		6
+#define ADLAR		5
+/* ADCSRA */
+#define ADEN		7
+#define ADSC		6
+#define ADATE		5
+#define ADIF		4
+#define ADIE		3
+#define ADPS2		2
+#define ADPS1		1
+#define ADPS0		0
+/* SFIOR */
+#define ADTS2		7
+#define ADTS1		6
+#define ADTS0		5
+
+#endif /* HOST_AVR_IO_H_ */
@@ -0,0 +1,24 @@
+/******************************************************************************
+ *
+ * Module: Host simulation shims
+ *
+ * File Name: pgmspace.h
+ *
+ * Description: Stand-in for <avr/pgmspace.h> in the host simulation builds,
+ * 				the host has one address space so flash reads are plain reads
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#define PROGMEM
+#define PSTR(s)					(s)
+
+#define pgm_read_byte(address)	(*(const unsigned char *)(address))
+#define pgm_read_word(address)	(*(const unsigned short *)(address))
+#define pgm_read_ptr(address)	(*(const void * const *)(address))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
@@ -0,0 +1,23 @@
+/******************************************************************************
+ *
+ * Module: Host simulation shims
+ *
+ * File Name: io_host.c
+ *
+ * Description: The register variables of the <avr/io.h> stand-in
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <avr/io.h>
+
+volatile unsigned char PORTA, DDRA, PINA;
+volatile unsigned char PORTB, DDRB, PINB;
+volatile unsigned char PORTC, DDRC, PINC;
+volatile unsigned char PORTD, DDRD, PIND;
+
+volatile unsigned char SREG;
+
+volatile unsigned char ADMUX, ADCSRA, SFIOR;
+volatile unsigned short ADC;
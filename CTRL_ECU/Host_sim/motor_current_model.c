@@ -0,0 +1,186 @@
+/******************************************************************************
+ *
+ * Module: Motor current model
+ *
+ * File Name: motor_current_model.c
+ *
+ * Description: Host model of the door DC motor and its current sense, it gives the
+ * 				ADC samples seen by the current monitor
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "motor_current_model.h"
+#include <math.h>
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+#define MOTOR_MODEL_PI					3.14159265358979
+/* below this speed the load torque holds the rotor (static friction) */
+#define MOTOR_MODEL_REST_SPEED			0.5
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static const MOTOR_MODEL_ConfigType g_defaultConfig =
+{
+	12.0,		/* supplyVolts */
+	2.0,		/* resistanceOhms */
+	0.002,		/* inductanceHenry */
+	0.02,		/* motorConstant */
+	0.00001,	/* inertia */
+	0.000005,	/* viscousFriction */
+	0.006,		/* loadTorque */
+	0.5,		/* senseVoltsPerAmpere */
+	1000.0,		/* senseFilterHz */
+	5.0,		/* adcReferenceVolts */
+	256.0,		/* pwmPeriodUs */
+	3			/* noiseCounts */
+};
+
+static MOTOR_MODEL_ConfigType g_config;
+/* resistance of the short between the motor leads, 0 = no short */
+static float64 g_shortResistance;
+static sint8 g_direction;
+static uint8 g_duty;
+static boolean g_jammed;
+/* state: motor current (A), speed (rad/s), sense filter output (A) */
+static float64 g_current;
+static float64 g_speed;
+static float64 g_sense;
+static uint32 g_noiseSeed;
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+void MOTOR_MODEL_init(const MOTOR_MODEL_ConfigType *Config_Ptr)
+{
+	g_config = (Config_Ptr != NULL_PTR) ? *Config_Ptr : g_defaultConfig;
+	g_shortResistance = 0;
+	g_direction = 0;
+	g_duty = 0;
+	g_jammed = FALSE;
+	g_current = 0;
+	g_speed = 0;
+	g_sense = 0;
+	g_noiseSeed = 12345;
+}
+
+void MOTOR_MODEL_setDrive(sint8 direction, uint8 duty)
+{
+	g_direction = direction;
+	g_duty = duty;
+}
+
+void MOTOR_MODEL_step(float64 us)
+{
+	float64 dt = us * 1e-6;
+	float64 volts = g_direction * g_config.supplyVolts * g_duty / 255.0;
+	float64 backEmf = g_config.motorConstant * g_speed;
+	float64 torque, next, sensed;
+
+	/* armature: L di/dt = v - R i - e, the average of the PWM voltage */
+	next = g_current + ((volts - (g_config.resistanceOhms * g_current) - backEmf) * dt / g_config.inductanceHenry);
+	if((g_direction == 0) && (next * g_current <= 0))
+	{
+		/* bridge off: the current decays through the diodes and does not reverse */
+		next = 0;
+	}
+	g_current = next;
+
+	/* rotor with the door */
+	if(g_jammed == TRUE)
+	{
+		g_speed = 0;
+	}
+	else
+	{
+		torque = (g_config.motorConstant * g_current) - (g_config.viscousFriction * g_speed);
+		if(fabs(g_speed) > MOTOR_MODEL_REST_SPEED)
+		{
+			torque -= (g_speed > 0) ? g_config.loadTorque : -g_config.loadTorque;
+			next = g_speed + (torque * dt / g_config.inertia);
+			/* the friction stops the rotor, it does not turn it back */
+			g_speed = (next * g_speed <= 0) ? 0 : next;
+		}
+		else if(fabs(torque) > g_config.loadTorque)
+		{
+			torque -= (torque > 0) ? g_config.loadTorque : -g_config.loadTorque;
+			g_speed += torque * dt / g_config.inertia;
+		}
+		else
+		{
+			g_speed = 0;
+		}
+	}
+
+	/* the sense sees the short as well, its filter (first order) gets the current magnitude */
+	sensed = g_current;
+	if(g_shortResistance > 0)
+	{
+		sensed += volts / g_shortResistance;
+	}
+	g_sense += (fabs(sensed) - g_sense) * (1.0 - exp(-2.0 * MOTOR_MODEL_PI * g_config.senseFilterHz * dt));
+}
+
+uint16 MOTOR_MODEL_sample(float64 nowUs)
+{
+	float64 duty = g_duty / 255.0;
+	float64 phase, ripple, fc, f, counts;
+	sint32 noise;
+
+	/*
+	 * PWM ripple of the current (triangle, rising in the on time), peak to peak
+	 * V d (1 - d) / (L f), reduced by the sense filter at the PWM frequency
+	 */
+	f = 1e6 / g_config.pwmPeriodUs;
+	fc = g_config.senseFilterHz;
+	ripple = (g_direction == 0) ? 0 :
+			(g_config.supplyVolts * duty * (1.0 - duty) / (g_config.inductanceHenry * f)) / sqrt(1.0 + ((f / fc) * (f / fc)));
+	phase = fmod(nowUs, g_config.pwmPeriodUs) / g_config.pwmPeriodUs;
+	if(phase < duty)
+	{
+		ripple *= (phase / duty) - 0.5;
+	}
+	else
+	{
+		ripple *= 0.5 - ((phase - duty) / (1.0 - duty));
+	}
+
+	/* fixed seed noise, the runs are repeatable */
+	g_noiseSeed = (g_noiseSeed * 1103515245u) + 12345u;
+	noise = (sint32)((g_noiseSeed >> 16) % (2u * g_config.noiseCounts + 1u)) - g_config.noiseCounts;
+
+	counts = ((g_sense + ripple) * g_config.senseVoltsPerAmpere * 1024.0 / g_config.adcReferenceVolts) + noise;
+	if(counts < 0)
+	{
+		return 0;
+	}
+	if(counts > 1023)
+	{
+		return 1023;
+	}
+	return (uint16)counts;
+}
+
+void MOTOR_MODEL_setJammed(boolean jammed)
+{
+	g_jammed = jammed;
+}
+
+void MOTOR_MODEL_setLeadShort(float64 resistanceOhms)
+{
+	g_shortResistance = resistanceOhms;
+}
+
+float64 MOTOR_MODEL_getCurrent(void)
+{
+	return g_current;
+}
+
+float64 MOTOR_MODEL_getSpeed(void)
+{
+	return g_speed;
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ * Module: Motor current model
+ *
+ * File Name: motor_current_model.h
+ *
+ * Description: Header file for the host model of the door DC motor and its current
+ * 				sense, it gives the ADC samples seen by the current monitor
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef MOTOR_CURRENT_MODEL_H_
+#define MOTOR_CURRENT_MODEL_H_
+
+#include "std_types.h"
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: MOTOR_MODEL_ConfigType
+ *
+ * [Description]: Electrical and mechanical constants of the motor, the door load and the sense chain
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * supplyVolts: H-bridge supply, the average motor voltage is supplyVolts * duty / 255
+	 */
+			float64	supplyVolts;
+	/*
+	 * resistanceOhms, inductanceHenry: armature winding
+	 */
+			float64	resistanceOhms;
+			float64	inductanceHenry;
+	/*
+	 * motorConstant: back EMF (V per rad/s) and torque (Nm per A) constant
+	 */
+			float64	motorConstant;
+	/*
+	 * inertia (kg m^2), viscousFriction (Nm per rad/s) and loadTorque (Nm, against the motion)
+	 * of the motor with the door
+	 */
+			float64	inertia;
+			float64	viscousFriction;
+			float64	loadTorque;
+	/*
+	 * senseVoltsPerAmpere, senseFilterHz: current sense amplifier gain and its output filter
+	 */
+			float64	senseVoltsPerAmpere;
+			float64	senseFilterHz;
+	/*
+	 * adcReferenceVolts: ADC full scale (1024 counts)
+	 */
+			float64	adcReferenceVolts;
+	/*
+	 * pwmPeriodUs: PWM period, gives the current ripple
+	 */
+			float64	pwmPeriodUs;
+	/*
+	 * noiseCounts: uniform noise added to every sample (+/-), from a fixed seed
+	 */
+			uint8	noiseCounts;
+}MOTOR_MODEL_ConfigType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*
+ * Description :
+ * Reset the model to a motor at rest without faults. Config_Ptr may be NULL_PTR for the
+ * default motor: 12 V, 2 ohm (6 A locked rotor), 0.3 A running current, 0.5 V per A.
+ */
+void MOTOR_MODEL_init(const MOTOR_MODEL_ConfigType *Config_Ptr);
+
+/*
+ * Description :
+ * Set the H-bridge drive: direction +1, -1 or 0 (bridge off) and the PWM duty (0-255).
+ */
+void MOTOR_MODEL_setDrive(sint8 direction, uint8 duty);
+
+/*
+ * Description :
+ * Advance the model by us microseconds.
+ */
+void MOTOR_MODEL_step(float64 us);
+
+/*
+ * Description :
+ * Return the ADC result of the current sense at the time nowUs (PWM ripple phase).
+ */
+uint16 MOTOR_MODEL_sample(float64 nowUs);
+
+/*
+ * Description :
+ * Fault injection: the door is blocked (the rotor cannot turn).
+ */
+void MOTOR_MODEL_setJammed(boolean jammed);
+
+/*
+ * Description :
+ * Fault injection: a short of resistanceOhms between the motor leads, after the current
+ * sense (0 = no short).
+ */
+void MOTOR_MODEL_setLeadShort(float64 resistanceOhms);
+
+/*
+ * Description :
+ * Return the motor current (A, signed) and speed (rad/s).
+ */
+float64 MOTOR_MODEL_getCurrent(void);
+float64 MOTOR_MODEL_getSpeed(void);
+
+#endif /* MOTOR_CURRENT_MODEL_H_ */
@@ -0,0 +1,74 @@
+/******************************************************************************
+ *
+ * Module: Timer
+ *
+ * File Name: timer_host.c
+ *
+ * Description: Host backend of the Timer driver API (timer.h), the simulation
+ * 				raises the timer events itself
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "timer_host.h"
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+#define HOST_TIMER_NUM_OF_TIMERS		3
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static TIMER_ConfigType g_config[HOST_TIMER_NUM_OF_TIMERS];
+static uint16 g_compareValue[HOST_TIMER_NUM_OF_TIMERS];
+static void (*g_callBackPtr[HOST_TIMER_NUM_OF_TIMERS])(void);
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+void Timer_setCallBack(void(*a_ptr)(void), TIMER_ID Timer_ID)
+{
+	g_callBackPtr[Timer_ID] = a_ptr;
+}
+
+void Timer_init(const TIMER_ConfigType * Config_Ptr)
+{
+	g_config[Config_Ptr->Timer_ID] = *Config_Ptr;
+	g_compareValue[Config_Ptr->Timer_ID] = Config_Ptr->Compare_value;
+}
+
+void Timer_DeInit(TIMER_ID Timer_ID)
+{
+	g_config[Timer_ID].prescaler = NO_CLOCK;
+}
+
+void Timer_setCompareValue(uint16 Compare_value, TIMER_ID Timer_ID)
+{
+	g_compareValue[Timer_ID] = Compare_value;
+}
+
+void Timer_setCompareOutput(boolean enable, TIMER_ID Timer_ID)
+{
+	(void)enable;
+	(void)Timer_ID;
+}
+
+void HOST_TIMER_event(TIMER_ID Timer_ID)
+{
+	if((g_config[Timer_ID].prescaler != NO_CLOCK) && (g_callBackPtr[Timer_ID] != NULL_PTR))
+	{
+		(*g_callBackPtr[Timer_ID])();
+	}
+}
+
+uint16 HOST_TIMER_getCompareValue(TIMER_ID Timer_ID)
+{
+	return g_compareValue[Timer_ID];
+}
+
+const TIMER_ConfigType *HOST_TIMER_getConfig(TIMER_ID Timer_ID)
+{
+	return &g_config[Timer_ID];
+}
@@ -0,0 +1,41 @@
+/******************************************************************************
+ *
+ * Module: Timer
+ *
+ * File Name: timer_host.h
+ *
+ * Description: Header file for the host backend of the Timer driver API (timer.h),
+ * 				the simulation raises the timer events itself
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef TIMER_HOST_H_
+#define TIMER_HOST_H_
+
+#include "timer.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*
+ * Description :
+ * Run the call back function of a timer, as its interrupt would
+ * (overflow in fast PWM mode, compare match in compare mode).
+ */
+void HOST_TIMER_event(TIMER_ID Timer_ID);
+
+/*
+ * Description :
+ * Return the compare value (the duty in fast PWM mode) of a timer.
+ */
+uint16 HOST_TIMER_getCompareValue(TIMER_ID Timer_ID);
+
+/*
+ * Description :
+ * Return the configuration given to Timer_init.
+ */
+const TIMER_ConfigType *HOST_TIMER_getConfig(TIMER_ID Timer_ID);
+
+#endif /* TIMER_HOST_H_ */
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *
+ * Module: TWI(I2C)
+ *
+ * File Name: twi_host.c
+ *
+ * Description: Host backend of the TWI driver API (twi.h), the bus is connected to the
+ * 				24C16 model so external_eeprom.c builds natively without any change
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "twi.h"
+#include "eeprom_24c16_model.h"
+#include "host_clock.h"
+
+#ifndef F_CPU
+#define F_CPU 8000000UL
+#endif
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+/* status codes the driver does not check by name */
+#define TWI_MT_DATA_NACK		0x30
+#define TWI_MR_SLA_NACK			0x48
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static uint8 g_status = 0xF8;
+/* TRUE between a start and a stop condition */
+static boolean g_busOwned = FALSE;
+/* TRUE when the next written byte is the slave address */
+static boolean g_addressNext = FALSE;
+/* SCL period in nanoseconds, from the bit rate configuration */
+static uint32 g_sclPeriodNs = 2500;
+static uint32 g_pendingNs = 0;
+
+/*------------------------------------------------------------------------------
+ *                      Functions Prototypes(Private)                          *
+-------------------------------------------------------------------------------*/
+static void TWI_spendClocks(uint8 clocks);
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+static void TWI_spendClocks(uint8 clocks)
+{
+	/* keep the sub-microsecond part so a long transfer is timed exactly */
+	g_pendingNs += (uint32)clocks * g_sclPeriodNs;
+	HOST_CLOCK_advanceUs(g_pendingNs / 1000);
+	g_pendingNs %= 1000;
+}
+
+void TWI_init(const TWI_ConfigType * Config_Ptr)
+{
+	/* SCL = F_CPU / (16 + 2 * TWBR * 4^TWPS) */
+	uint32 divider = 16 + (2UL * Config_Ptr->BitRateRegister_TWBR * (1UL << (2 * Config_Ptr->prescaler)));
+
+	g_sclPeriodNs = (uint32)((1000000000ULL * divider) / F_CPU);
+	g_busOwned = FALSE;
+	g_status = 0xF8;
+}
+
+void TWI_start(void)
+{
+	g_status = g_busOwned ? TWI_REP_START : TWI_START;
+	g_busOwned = TRUE;
+	g_addressNext = TRUE;
+	EEPROM_MODEL_busStart();
+	TWI_spendClocks(1);
+}
+
+void TWI_stop(void)
+{
+	if (g_busOwned)
+	{
+		EEPROM_MODEL_busStop();
+		TWI_spendClocks(1);
+	}
+	g_busOwned = FALSE;
+	g_status = 0xF8;
+}
+
+void TWI_writeByte(uint8 data)
+{
+	/* 8 data bits + acknowledge */
+	TWI_spendClocks(9);
+
+	if (g_addressNext)
+	{
+		g_addressNext = FALSE;
+		if (data & 0x01)
+			g_status = EEPROM_MODEL_busAddress(data) ? TWI_MT_SLA_R_ACK : TWI_MR_SLA_NACK;
+		else
+			g_status = EEPROM_MODEL_busAddress(data) ? TWI_MT_SLA_W_ACK : TWI_MT_SLA_W_NACK;
+	}
+	else
+	{
+		g_status = EEPROM_MODEL_busWrite(data) ? TWI_MT_DATA_ACK : TWI_MT_DATA_NACK;
+	}
+}
+
+uint8 TWI_readByteWithACK(void)
+{
+	TWI_spendClocks(9);
+	g_status = TWI_MR_DATA_ACK;
+	return EEPROM_MODEL_busRead();
+}
+
+uint8 TWI_readByteWithNACK(void)
+{
+	TWI_spendClocks(9);
+	g_status = TWI_MR_DATA_NACK;
+	return EEPROM_MODEL_busRead();
+}
+
+uint8 TWI_getStatus(void)
+{
+	return g_status;
+}
@@ -0,0 +1,253 @@
+/******************************************************************************
+ *
+ * Module: Lockout manager
+ *
+ * File Name: lockout.c
+ *
+ * Description: Source file for the wrong password lockout manager (failure window
+ * 				and exponential backoff of the lockout time)
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "lockout.h"
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+/* times of the wrong passwords inside the window, oldest first */
+static uint32 g_failureTicks[LOCKOUT_MAX_FAILURES];
+static uint8 g_failures = 0;
+
+/* lockouts in a row */
+static uint8 g_level = 0;
+static boolean g_locked = FALSE;
+static uint32 g_lockStart = 0;
+static uint32 g_lockTicks = 0;
+
+/* start of the time without wrong passwords, for the reset of the backoff level */
+static uint32 g_quietStart = 0;
+
+/* last state written to the log storage */
+static LOCKOUT_RecordType g_savedRecord = {0, 0, FALSE};
+
+/*------------------------------------------------------------------------------
+ *                      Functions Prototypes(Private)                          *
+-------------------------------------------------------------------------------*/
+static void LOCKOUT_save(void);
+static void LOCKOUT_start(uint32 now);
+static void LOCKOUT_forgetOldFailures(uint32 now);
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*
+ * Write the state to the log storage, nothing is written if it did not change
+ */
+static void LOCKOUT_save(void)
+{
+	LOCKOUT_RecordType record;
+
+	record.failures = g_failures;
+	record.level = g_level;
+	record.locked = g_locked;
+
+	if((record.failures != g_savedRecord.failures) || (record.level != g_savedRecord.level) ||
+			(record.locked != g_savedRecord.locked))
+	{
+		if(LOG_write(LOG_KEY_WRONG_ATTEMPTS, (const uint8 *)&record, sizeof(record)) == SUCCESS)
+		{
+			g_savedRecord = record;
+		}
+	}
+}
+
+/*
+ * Start a lockout, it lasts LOCKOUT_BASE_TIME_S doubled for every earlier lockout in a row
+ */
+static void LOCKOUT_start(uint32 now)
+{
+	g_locked = TRUE;
+	g_lockStart = now;
+	g_lockTicks = SECONDS_TO_TICKS((uint16)LOCKOUT_BASE_TIME_S << (g_level - 1));
+	g_failures = 0;
+}
+
+/*
+ * Drop the wrong passwords that left the failure window
+ */
+static void LOCKOUT_forgetOldFailures(uint32 now)
+{
+	uint8 i, old = 0;
+
+	while((old < g_failures) &&
+			((now - g_failureTicks[old]) >= SECONDS_TO_TICKS(LOCKOUT_FAILURE_WINDOW_S)))
+	{
+		old++;
+	}
+	if(old != 0)
+	{
+		for(i = old; i < g_failures; i++)
+		{
+			g_failureTicks[i - old] = g_failureTicks[i];
+		}
+		g_failures -= old;
+	}
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_init
+ *
+ * [Description]:  Function to restore the lockout state from the log storage (LOG_init
+ * 					must run first), the restored failures are stamped with the boot time
+ *
+ * [Args]:        now: ticks since boot
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void LOCKOUT_init(uint32 now)
+{
+	uint8 i;
+	uint8 attempts;
+
+	if(LOG_read(LOG_KEY_WRONG_ATTEMPTS, (uint8 *)&g_savedRecord, sizeof(g_savedRecord)) != SUCCESS)
+	{
+		g_savedRecord.level = 0;
+		g_savedRecord.locked = FALSE;
+		/* record of the older firmware: the number of wrong attempts only */
+		g_savedRecord.failures = (LOG_read(LOG_KEY_WRONG_ATTEMPTS, &attempts, 1) == SUCCESS) ? attempts : 0;
+	}
+
+	g_level = (g_savedRecord.level <= (LOCKOUT_MAX_LEVEL + 1)) ? g_savedRecord.level : (LOCKOUT_MAX_LEVEL + 1);
+	g_quietStart = now;
+
+	if((g_savedRecord.locked == TRUE) || (g_savedRecord.failures >= LOCKOUT_MAX_FAILURES))
+	{
+		/* reset while locked: the lockout starts again in full */
+		if(g_level == 0)
+		{
+			g_level = 1;
+		}
+		LOCKOUT_start(now);
+	}
+	else
+	{
+		g_failures = g_savedRecord.failures;
+		for(i = 0; i < g_failures; i++)
+		{
+			g_failureTicks[i] = now;
+		}
+	}
+	LOCKOUT_save();
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_recordFailure
+ *
+ * [Description]:  Function to count a wrong password, the LOCKOUT_MAX_FAILURES th one
+ * 					inside the failure window starts a lockout
+ *
+ * [Args]:        now: ticks since boot
+ *
+ * [Returns]:      The wrong passwords inside the window including this one,
+ * 				   LOCKOUT_MAX_FAILURES when the lockout started
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOCKOUT_recordFailure(uint32 now)
+{
+	if(LOCKOUT_getRemainingSeconds(now) != 0)
+	{
+		/* the passwords are not checked during a lockout */
+		return LOCKOUT_MAX_FAILURES;
+	}
+
+	if((now - g_quietStart) >= SECONDS_TO_TICKS(LOCKOUT_RESET_TIME_S))
+	{
+		g_level = 0;
+	}
+	g_quietStart = now;
+
+	LOCKOUT_forgetOldFailures(now);
+	g_failureTicks[g_failures] = now;
+	g_failures++;
+
+	if(g_failures == LOCKOUT_MAX_FAILURES)
+	{
+		if(g_level <= LOCKOUT_MAX_LEVEL)
+		{
+			g_level++;
+		}
+		LOCKOUT_start(now);
+		LOCKOUT_save();
+		return LOCKOUT_MAX_FAILURES;
+	}
+	LOCKOUT_save();
+	return g_failures;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_recordSuccess
+ *
+ * [Description]:  Function to forget the wrong passwords and the backoff level after
+ * 					a correct password
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void LOCKOUT_recordSuccess(void)
+{
+	g_failures = 0;
+	g_level = 0;
+	LOCKOUT_save();
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_getRemainingSeconds
+ *
+ * [Description]:  Function to check the lockout, it ends here when its time is over
+ *
+ * [Args]:        now: ticks since boot
+ *
+ * [Returns]:      Seconds left (rounded up), 0 if the passwords are accepted
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 LOCKOUT_getRemainingSeconds(uint32 now)
+{
+	uint32 elapsed;
+
+	if(g_locked == FALSE)
+	{
+		return 0;
+	}
+
+	elapsed = now - g_lockStart;
+	if(elapsed >= g_lockTicks)
+	{
+		/* the time without wrong passwords starts at the end of the lockout */
+		g_locked = FALSE;
+		g_quietStart = g_lockStart + g_lockTicks;
+		LOCKOUT_save();
+		return 0;
+	}
+
+	return (uint16)((g_lockTicks - elapsed + TICKS_PER_SECOND - 1) / TICKS_PER_SECOND);
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_getLevel
+ *
+ * [Description]:  Function to get the backoff level (number of lockouts in a row)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      The backoff level, 0 to LOCKOUT_MAX_LEVEL + 1
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOCKOUT_getLevel(void)
+{
+	return g_level;
+}
@@ -0,0 +1,131 @@
+/******************************************************************************
+ *
+ * Module: Lockout manager
+ *
+ * File Name: lockout.h
+ *
+ * Description: Header file for the wrong password lockout manager (failure window
+ * 				and exponential backoff of the lockout time)
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef LOCKOUT_H_
+#define LOCKOUT_H_
+
+#include "std_types.h"
+#include "log_storage.h"
+#include "timer.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+/* wrong passwords inside the failure window that start a lockout */
+#define LOCKOUT_MAX_FAILURES			3
+/* a wrong password older than this is forgotten */
+#define LOCKOUT_FAILURE_WINDOW_S		600
+
+/*
+ * Every lockout in a row doubles the next one: 60sec, 2min, 4min ... up to 60sec << LOCKOUT_MAX_LEVEL.
+ * The level goes back to zero with a correct password or after LOCKOUT_RESET_TIME_S
+ * without a wrong password.
+ */
+#define LOCKOUT_BASE_TIME_S				60
+#define LOCKOUT_MAX_LEVEL				5
+#define LOCKOUT_RESET_TIME_S			3600
+
+#if ((LOCKOUT_BASE_TIME_S << LOCKOUT_MAX_LEVEL) > 0xFFFF)
+#error "The longest lockout must fit the 16-bit seconds of the lockout reply"
+#endif
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: LOCKOUT_RecordType
+ *
+ * [Description]: State kept in the log storage (LOG_KEY_WRONG_ATTEMPTS), a reset does
+ * 					not clear the failures nor a running lockout
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * failures: wrong passwords inside the failure window
+	 */
+			uint8	failures;
+	/*
+	 * level: lockouts in a row, the last one lasted LOCKOUT_BASE_TIME_S << (level - 1)
+	 */
+			uint8	level;
+	/*
+	 * locked: TRUE while a lockout runs, it starts again in full after a reset
+	 */
+			uint8	locked;
+}LOCKOUT_RecordType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_init
+ *
+ * [Description]:  Function to restore the lockout state from the log storage (LOG_init
+ * 					must run first), the restored failures are stamped with the boot time
+ *
+ * [Args]:        now: ticks since boot
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void LOCKOUT_init(uint32 now);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_recordFailure
+ *
+ * [Description]:  Function to count a wrong password, the LOCKOUT_MAX_FAILURES th one
+ * 					inside the failure window starts a lockout
+ *
+ * [Args]:        now: ticks since boot
+ *
+ * [Returns]:      The wrong passwords inside the window including this one,
+ * 				   LOCKOUT_MAX_FAILURES when the lockout started
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOCKOUT_recordFailure(uint32 now);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_recordSuccess
+ *
+ * [Description]:  Function to forget the wrong passwords and the backoff level after
+ * 					a correct password
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void LOCKOUT_recordSuccess(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_getRemainingSeconds
+ *
+ * [Description]:  Function to check the lockout, it ends here when its time is over
+ *
+ * [Args]:        now: ticks since boot
+ *
+ * [Returns]:      Seconds left (rounded up), 0 if the passwords are accepted
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 LOCKOUT_getRemainingSeconds(uint32 now);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOCKOUT_getLevel
+ *
+ * [Description]:  Function to get the backoff level (number of lockouts in a row)
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      The backoff level, 0 to LOCKOUT_MAX_LEVEL + 1
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOCKOUT_getLevel(void);
+
+#endif /* LOCKOUT_H_ */
@@ -0,0 +1,296 @@
+/******************************************************************************
+ *
+ * Module: Log storage
+ *
+ * File Name: log_storage.c
+ *
+ * Description: Source file for the wear-leveled log-structured key/value store
+ * 				kept in the external EEPROM
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "log_storage.h"
+#include "crc16.h"
+
+#if (LOG_NUM_OF_KEYS >= LOG_SLOTS_PER_SEGMENT)
+#error "The live records of one segment must fit in the segment before it"
+#endif
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+#define LOG_NO_SLOT						0xFF
+#define LOG_CRC_COVERED_BYTES			(sizeof(LOG_RecordType) - sizeof(uint16))
+
+#define LOG_SLOT_ADDRESS(slot)			(LOG_START_ADDRESS + ((uint16)(slot) * LOG_SLOT_SIZE))
+#define LOG_SEGMENT_OF(slot)			((slot) / LOG_SLOTS_PER_SEGMENT)
+
+/* TRUE if sequence a was appended after sequence b (wraps around like the counter) */
+#define LOG_IS_NEWER(a,b)				((sint16)((uint16)((a) - (b))) > 0)
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+/* slot of the latest record of every key, LOG_NO_SLOT if the key was never written */
+static uint8 g_index[LOG_NUM_OF_KEYS];
+/* next slot to be written and the sequence number it will get */
+static uint8 g_head = 0;
+static uint16 g_sequence = 0;
+/* bytes and pages written/skipped by the read-compare-write since boot */
+static EEPROM_UpdateReportType g_writeReport = {0,0,0,0};
+
+/*------------------------------------------------------------------------------
+ *                      Functions Prototypes(Private)                          *
+-------------------------------------------------------------------------------*/
+static boolean LOG_isValid(const LOG_RecordType *record);
+static uint8 LOG_readSlot(uint8 slot, LOG_RecordType *record);
+static uint8 LOG_program(LOG_RecordType *record);
+static uint8 LOG_compact(void);
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+static boolean LOG_isValid(const LOG_RecordType *record)
+{
+	return (record->key < LOG_NUM_OF_KEYS) &&
+		   (record->length <= LOG_MAX_DATA_LENGTH) &&
+		   (record->crc == CRC16_update(CRC16_INITIAL_VALUE, (const uint8 *)record, LOG_CRC_COVERED_BYTES));
+}
+
+static uint8 LOG_readSlot(uint8 slot, LOG_RecordType *record)
+{
+	return EEPROM_readBlock(LOG_SLOT_ADDRESS(slot), (uint8 *)record, sizeof(LOG_RecordType));
+}
+
+/*
+ * Description :
+ * Give the record the next sequence number, write it at the head and move the head.
+ * The index is updated only if the record reads back valid, a failed slot is skipped
+ * so it is not written again and again.
+ */
+static uint8 LOG_program(LOG_RecordType *record)
+{
+	LOG_RecordType check;
+	uint8 slot = g_head;
+	uint8 status;
+
+	record->sequence = g_sequence;
+	record->crc = CRC16_update(CRC16_INITIAL_VALUE, (const uint8 *)record, LOG_CRC_COVERED_BYTES);
+
+	g_head = (g_head + 1) % LOG_NUM_OF_SLOTS;
+	g_sequence++;
+
+	/* only the bytes that differ from the stale record in this slot are programmed */
+	status = EEPROM_updateBlock(LOG_SLOT_ADDRESS(slot), (const uint8 *)record, sizeof(LOG_RecordType), &g_writeReport);
+	if (status == SUCCESS)
+	{
+		status = LOG_readSlot(slot, &check);
+	}
+	if ((status == SUCCESS) && (check.crc == record->crc) && LOG_isValid(&check))
+	{
+		g_index[record->key] = slot;
+		return SUCCESS;
+	}
+	return ERROR;
+}
+
+/*
+ * Description :
+ * Copy the live records of the segment after the head segment to the head. After that,
+ * the segment only holds superseded records and the head can write over it later.
+ * Called after every append and at boot, so a compaction torn by a power loss is finished.
+ */
+static uint8 LOG_compact(void)
+{
+	LOG_RecordType record;
+	uint8 nextSegment = (LOG_SEGMENT_OF(g_head) + 1) % LOG_NUM_OF_SEGMENTS;
+	uint8 key;
+
+	for (key = 0; key < LOG_NUM_OF_KEYS; key++)
+	{
+		if ((g_index[key] != LOG_NO_SLOT) && (LOG_SEGMENT_OF(g_index[key]) == nextSegment))
+		{
+			if ((LOG_readSlot(g_index[key], &record) == ERROR) || (LOG_program(&record) == ERROR))
+				return ERROR;
+		}
+	}
+	return SUCCESS;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_init
+ *
+ * [Description]:  Function to scan the log region in one sequential read, build the RAM index of the latest
+ * 					record of every key and recover the head position
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM communication failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOG_init(void)
+{
+	LOG_RecordType record;
+	uint16 keySequence[LOG_NUM_OF_KEYS];
+	boolean found = FALSE;
+	uint8 lastSlot = 0;
+	uint8 status;
+	uint8 slot, key;
+
+	for (key = 0; key < LOG_NUM_OF_KEYS; key++)
+	{
+		g_index[key] = LOG_NO_SLOT;
+	}
+
+	/*
+	 * the whole region in one sequential read, every record is parsed as soon as it
+	 * arrives so one record buffer is enough
+	 */
+	status = EEPROM_readBegin(LOG_SLOT_ADDRESS(0));
+	for (slot = 0; (slot < LOG_NUM_OF_SLOTS) && (status == SUCCESS); slot++)
+	{
+		status = EEPROM_readContinue((uint8 *)&record, sizeof(LOG_RecordType), slot == (LOG_NUM_OF_SLOTS - 1));
+
+		if ((status == SUCCESS) && LOG_isValid(&record))
+		{
+			/* the newest record in the whole log marks the head position */
+			if ((found == FALSE) || LOG_IS_NEWER(record.sequence, g_sequence))
+			{
+				g_sequence = record.sequence;
+				lastSlot = slot;
+				found = TRUE;
+			}
+			if ((g_index[record.key] == LOG_NO_SLOT) || LOG_IS_NEWER(record.sequence, keySequence[record.key]))
+			{
+				g_index[record.key] = slot;
+				keySequence[record.key] = record.sequence;
+			}
+		}
+	}
+	EEPROM_readEnd();
+
+	if (status == ERROR)
+		return ERROR;
+
+	if (found)
+	{
+		g_head = (lastSlot + 1) % LOG_NUM_OF_SLOTS;
+		g_sequence++;
+	}
+	else
+	{
+		g_head = 0;
+		g_sequence = 0;
+	}
+
+	return LOG_compact();
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_read
+ *
+ * [Description]:  Function to read the latest value of a key (one page read through the index)
+ *
+ * [Args]:        key: one of LOG_KeyType
+ * 				  data: a pointer to uint8 buffer to be filled
+ * 				  length: expected value length
+ *
+ * [Returns]:      SUCCESS if the key has a valid value of this length, LOG_NOT_FOUND if it
+ * 				   has none, ERROR in case of EEPROM communication failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOG_read(LOG_KeyType key, uint8 *data, uint8 length)
+{
+	LOG_RecordType record;
+	uint8 i;
+
+	if (key >= LOG_NUM_OF_KEYS)
+		return ERROR;
+
+	if (g_index[key] == LOG_NO_SLOT)
+		return LOG_NOT_FOUND;
+
+	/* the index only points at valid records, a record that does not read back valid is a bus fault */
+	if ((LOG_readSlot(g_index[key], &record) == ERROR) || !LOG_isValid(&record) || (record.key != key))
+		return ERROR;
+
+	/* a value of an other layout (older firmware) */
+	if (record.length != length)
+		return LOG_NOT_FOUND;
+
+	for (i = 0; i < length; i++)
+	{
+		data[i] = record.data[i];
+	}
+	return SUCCESS;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_write
+ *
+ * [Description]:  Function to append a new value of a key at the head of the log,
+ * 					nothing is appended if the latest value of the key is the same
+ *
+ * [Args]:        key: one of LOG_KeyType
+ * 				  data: a pointer to the value
+ * 				  length: value length, up to LOG_MAX_DATA_LENGTH
+ *
+ * [Returns]:      SUCCESS if the record is written and verified (or not needed), ERROR otherwise
+ * 				   (the previous value of the key stays valid in this case)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOG_write(LOG_KeyType key, const uint8 *data, uint8 length)
+{
+	LOG_RecordType record;
+	uint8 status;
+	uint8 i;
+
+	if ((key >= LOG_NUM_OF_KEYS) || (length > LOG_MAX_DATA_LENGTH))
+		return ERROR;
+
+	/* read-compare: the same value saved again costs one page read and no write */
+	if ((g_index[key] != LOG_NO_SLOT) && (LOG_readSlot(g_index[key], &record) == SUCCESS) &&
+		LOG_isValid(&record) && (record.key == key) && (record.length == length))
+	{
+		for (i = 0; (i < length) && (record.data[i] == data[i]); i++);
+		if (i == length)
+		{
+			g_writeReport.bytesSkipped += sizeof(LOG_RecordType);
+			g_writeReport.pagesSkipped++;
+			return SUCCESS;
+		}
+	}
+
+	record.key = key;
+	record.length = length;
+	for (i = 0; i < LOG_MAX_DATA_LENGTH; i++)
+	{
+		record.data[i] = (i < length) ? data[i] : 0;
+	}
+
+	status = LOG_program(&record);
+
+	/* keep the segment in front of the head free of live records */
+	if (LOG_compact() == ERROR)
+		status = ERROR;
+
+	return status;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_getWriteReport
+ *
+ * [Description]:  Function to get how many bytes and pages were written and skipped by
+ * 					the read-compare-write of the log storage since boot
+ *
+ * [Args]:        report: a pointer to EEPROM_UpdateReportType to be filled
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void LOG_getWriteReport(EEPROM_UpdateReportType *report)
+{
+	*report = g_writeReport;
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+ *
+ * Module: Log storage
+ *
+ * File Name: log_storage.h
+ *
+ * Description: Header file for the wear-leveled log-structured key/value store
+ * 				kept in the external EEPROM
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef LOG_STORAGE_H_
+#define LOG_STORAGE_H_
+
+#include "std_types.h"
+#include "external_eeprom.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+/*
+ * The store is a circular log of records, one record per EEPROM page. Every write
+ * appends a new record at the head, so the writes walk over the whole region and the
+ * wear is the same for every page. The region is split into segments; when the head
+ * enters a segment the live records of the following segment are copied to the head
+ * (compaction), so the head never reaches a record that is still the latest one of its key.
+ * The log takes 0x000-0x5FF, the rest of the EEPROM is the audit log ring (audit_log.h).
+ */
+#define LOG_START_ADDRESS				0x000
+#define LOG_SLOT_SIZE					EEPROM_PAGE_SIZE
+#define LOG_SLOTS_PER_SEGMENT			16
+#define LOG_NUM_OF_SEGMENTS				6
+#define LOG_NUM_OF_SLOTS				(LOG_SLOTS_PER_SEGMENT * LOG_NUM_OF_SEGMENTS)
+
+/* key(1) + length(1) + sequence(2) + crc(2) leave 10 data bytes in a 16 bytes page */
+#define LOG_MAX_DATA_LENGTH				(LOG_SLOT_SIZE - 6)
+
+/* LOG_read result when the key has no value of the requested length (never written) */
+#define LOG_NOT_FOUND					2
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+/*
+ * Keys of the stored values, the RAM index has one entry per key.
+ * The compaction needs LOG_NUM_OF_KEYS < LOG_SLOTS_PER_SEGMENT.
+ */
+typedef enum
+{
+	LOG_KEY_CREDENTIAL,LOG_KEY_WRONG_ATTEMPTS,LOG_NUM_OF_KEYS
+}LOG_KeyType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: LOG_RecordType
+ *
+ * [Description]: Layout of one record (one EEPROM page)
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * key: one of LOG_KeyType, an erased slot (0xFF) is not a valid key
+	 */
+			uint8	key;
+	/*
+	 * length: number of used bytes in data
+	 */
+			uint8	length;
+	/*
+	 * sequence: incremented by every appended record, the newest record of a key wins
+	 */
+			uint16	sequence;
+	/*
+	 * data: the stored value
+	 */
+			uint8	data[LOG_MAX_DATA_LENGTH];
+	/*
+	 * crc: CRC-16/CCITT of all the previous members, a record torn by a power loss fails it
+	 */
+			uint16	crc;
+}LOG_RecordType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_init
+ *
+ * [Description]:  Function to scan the log region in one sequential read, build the RAM index of the latest
+ * 					record of every key and recover the head position
+ *
+ * [Args]:        void
+ *
+ * [Returns]:      SUCCESS or ERROR in case of EEPROM communication failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOG_init(void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_read
+ *
+ * [Description]:  Function to read the latest value of a key (one page read through the index)
+ *
+ * [Args]:        key: one of LOG_KeyType
+ * 				  data: a pointer to uint8 buffer to be filled
+ * 				  length: expected value length
+ *
+ * [Returns]:      SUCCESS if the key has a valid value of this length, LOG_NOT_FOUND if it
+ * 				   has none, ERROR in case of EEPROM communication failure
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOG_read(LOG_KeyType key, uint8 *data, uint8 length);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_write
+ *
+ * [Description]:  Function to append a new value of a key at the head of the log,
+ * 					nothing is appended if the latest value of the key is the same
+ *
+ * [Args]:        key: one of LOG_KeyType
+ * 				  data: a pointer to the value
+ * 				  length: value length, up to LOG_MAX_DATA_LENGTH
+ *
+ * [Returns]:      SUCCESS if the record is written and verified (or not needed), ERROR otherwise
+ * 				   (the previous value of the key stays valid in this case)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 LOG_write(LOG_KeyType key, const uint8 *data, uint8 length);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: LOG_getWriteReport
+ *
+ * [Description]:  Function to get how many bytes and pages were written and skipped by
+ * 					the read-compare-write of the log storage since boot
+ *
+ * [Args]:        report: a pointer to EEPROM_UpdateReportType to be filled
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void LOG_getWriteReport(EEPROM_UpdateReportType *report);
+
+#endif /* LOG_STORAGE_H_ */
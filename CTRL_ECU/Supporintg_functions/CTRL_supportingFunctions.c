@@ -1,224 +1,426 @@
-
-/******************************************************************************
- *
- * Module: Control ECU supporting functions
- *
- * File Name: CTR_supportingFunctions.c
- *
- * Description: Functions than are implemented in the CTRL ECU main function
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-#include "CTRL_supportingFunctions.h"
-
-/*------------------------------------------------------------------------------
- *                              Global Variables                                *
---------------------------------------------------------------------------------*/
-uint32 g_ticks;
-uint8 g_password[PASSWORD_LENGTH];
-/*--------------------------------------------------------------------------
- *                       Functions Definitions                            *
- ----------------------------------------------------------------------------*/
-/*---------------------------------------------------------------------------
- * [Function Name]: Receive_password_from_HMI_ECU
- *
- * [Description]:  Function that receives the password fro the HMI ECU via UART
- *
- * [Args]:         password: a pointer to uint8 data
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Receive_password_from_HMI_ECU (uint8 * password)
-{
-	uint8 i;
-	for (i=0;i<PASSWORD_LENGTH;i++)
-	{
-		password[i]=UART_recieveByte();
-		_delay_ms(50);
-	}
-}
-/*---------------------------------------------------------------------------
- * [Function Name]: Compare_passwords
- *
- * [Description]:  Function that compares the passwords received fron the HMI ECU
- *
- * [Args]:         password1,password2:  pointers to uint8 data
- *
- * [Returns]:      uint8 data: indicated the passwords status
- *
- ----------------------------------------------------------------------------------*/
-uint8 Compare_passwords (uint8 *password1, uint8 *password2)
-{
-	uint8 i,tempCounter=0;
-	for (i=0;i<PASSWORD_LENGTH;i++)
-	{
-		if (password1[i]==password2[i])
-			tempCounter++;
-	}
-	if (tempCounter==PASSWORD_LENGTH)
-
-		return PASSOWRD_MATCH;
-	else
-		return PASSWORD_UNMATCH;
-}
-/*---------------------------------------------------------------------------
- * [Function Name]: Save_passwordToEEPROM
- *
- * [Description]:  Function that saves the password in case they are matched
- *
- * [Args]:         password: a pointer to uint8 data
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Save_passwordToEEPROM (uint8 *password)
-{
-	uint8 i;
-	for(i=0;i<PASSWORD_LENGTH;i++)
-	{
-		EEPROM_writeByte(EEPROM_STORE_ADDREESS+i, password[i]);
-		g_password[i]=password[i];
-		_delay_ms(50);
-	}
-}
-
-/*---------------------------------------------------------------------------
- * [Function Name]: Setting_password_CTRL
- *
- * [Description]:  Function that gets the passwords from the user
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Setting_password_CTRL (void)
-{
-	/*
-	 *  FirstPassword: initialized password
-	 *  SecondPassword: confirmation of password
-	 */
-	uint8 FirstPassword[PASSWORD_LENGTH];
-	uint8 SecondPassword[PASSWORD_LENGTH];
-
-	/*
-	 * variable used to store the state of 2 passwords received by from HMI ECU
-	 * can only be 2 cases:
-	 * 						1- PASSWORD_MATCH
-	 * 						2- PASSWORD_UNMATCH
-	 */
-	uint8 Password_State = PASSWORD_UNMATCH;
-
-	while(Password_State == PASSWORD_UNMATCH)
-	{
-		/*communications between the 2 ECUs to check if they are ready to synchronize  */
-		while (UART_recieveByte() != READY);
-		UART_sendByte(READY);
-		/*
-		 * receive first password from HMI ECU  to compare it
-		 *  with the confirmed password to check Matching
-		 */
-		Receive_password_from_HMI_ECU(FirstPassword);
-
-		while (UART_recieveByte() != READY);
-		UART_sendByte(READY);
-
-		/*
-		 * receive confirmed password from HMI ECU  to compare it
-		 *  with the first password to check Matching
-		 */
-		Receive_password_from_HMI_ECU(SecondPassword);
-
-		/*
-		 * compare the two passwords to check the matching state
-		 */
-		Password_State = Compare_passwords(FirstPassword, SecondPassword);
-
-		UART_sendByte(READY);
-
-		UART_sendByte(Password_State);
-
-		if ( Password_State == PASSOWRD_MATCH)
-		{
-			/*
-			 * in case of matching: save to EEPROM
-			 */
-			Save_passwordToEEPROM(FirstPassword);
-		}
-	}
-}
-/*---------------------------------------------------------------------------
- * [Function Name]: Timer_callBack
- *
- * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-
-void Timer_callBack (void)
-{
-	g_ticks++;
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Door_tasksCTRL
- *
- * [Description]:  Function to display door state
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Door_tasksCTRL(void)
-{
-	/*
-	 * make g_ticks zero to start calculation and comparison of time
-	 */
-	g_ticks = 0;
-	DcMotor_Rotate(CW);
-	/*
-	 * wait until door next state
-	 */
-	while (g_ticks < DOOR_OPENNING_TIME);
-
-	g_ticks = 0;
-	DcMotor_Rotate(STOP);
-	/*
-	 * wait until door next state
-	 */
-	while (g_ticks < DOOR_LEFT_OPEN_TIME);
-	g_ticks = 0;
-	DcMotor_Rotate(ACW);
-	/*
-	 * wait until door next state
-	 */
-	while (g_ticks < DOOR_CLOSING_TIME);
-
-	DcMotor_Rotate(STOP);
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: dangerAlert
- *
- * [Description]:  Function to display a msg in case of un-matched passwords
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void dangerMission(void)
-{
-
-	g_ticks=0;
-	Buzzer_ON();
-	/*
-	 * wait until finishing danger time
-	 */
-	while(g_ticks < DANGER_TIME);
-	Buzzer_OFF();
-}
+
+/******************************************************************************
+ *
+ * Module: Control ECU supporting functions
+ *
+ * File Name: CTR_supportingFunctions.c
+ *
+ * Description: Functions than are implemented in the CTRL ECU main function
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+#include "CTRL_supportingFunctions.h"
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+volatile uint32 g_ticks;
+/*ticks since boot, never reset by the door and danger tasks*/
+volatile uint32 g_uptimeTicks;
+uint8 g_password[PASSWORD_LENGTH];
+/*ticks of the alarm start, the Timer1 call back ends the alarm after DANGER_TIME*/
+static volatile boolean g_alarmOn = FALSE;
+static uint32 g_alarmStart;
+/*--------------------------------------------------------------------------
+ *                       Functions Definitions                            *
+ ----------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------
+ * [Function Name]: Receive_password_from_HMI_ECU
+ *
+ * [Description]:  Function that receives the password fro the HMI ECU via UART
+ *
+ * [Args]:         password: a pointer to uint8 data
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Receive_password_from_HMI_ECU (uint8 * password)
+{
+	uint8 i;
+	for (i=0;i<PASSWORD_LENGTH;i++)
+	{
+		password[i]=UART_recieveByte();
+		_delay_ms(50);
+	}
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Compare_passwords
+ *
+ * [Description]:  Function that compares the passwords received fron the HMI ECU
+ *
+ * [Args]:         password1,password2:  pointers to uint8 data
+ *
+ * [Returns]:      uint8 data: indicated the passwords status
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 Compare_passwords (uint8 *password1, uint8 *password2)
+{
+	uint8 i,tempCounter=0;
+	for (i=0;i<PASSWORD_LENGTH;i++)
+	{
+		if (password1[i]==password2[i])
+			tempCounter++;
+	}
+	if (tempCounter==PASSWORD_LENGTH)
+
+		return PASSOWRD_MATCH;
+	else
+		return PASSWORD_UNMATCH;
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Save_passwordToEEPROM
+ *
+ * [Description]:  Function that saves the password in case they are matched
+ * 					as a new credential record (see credential_storage.h)
+ *
+ * [Args]:         password: a pointer to uint8 data
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Save_passwordToEEPROM (uint8 *password)
+{
+	uint8 i;
+	for(i=0;i<PASSWORD_LENGTH;i++)
+	{
+		g_password[i]=password[i];
+	}
+	/*
+	 * one record appended to the log storage, no fixed delay per byte is needed
+	 * if the write fails the previous record stays the valid one in the EEPROM
+	 */
+	Record_auditEvent(AUDIT_EVENT_PASSWORD_SET, CREDENTIAL_save(password));
+}
+
+/*---------------------------------------------------------------------------
+ * [Function Name]: Load_storage
+ *
+ * [Description]:  Function that rebuilds the log storage index, the audit log ring and the
+ * 					lockout state from the EEPROM and loads the saved password
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint8 data: SUCCESS, CREDENTIAL_NOT_SAVED or ERROR in case of EEPROM
+ * 					communication failure (see CREDENTIAL_load)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 Load_storage (void)
+{
+	/*
+	 * an index or a ring head built from a failed scan is not used: the next write could
+	 * overwrite the latest records
+	 */
+	if ((LOG_init() == ERROR) || (AUDIT_init() == ERROR))
+		return ERROR;
+
+	/*restore the wrong passwords and a lockout cut by a reset*/
+	LOCKOUT_init(Get_uptimeTicks());
+
+	return CREDENTIAL_load(g_password);
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Get_uptimeTicks
+ *
+ * [Description]:  Function that reads the ticks since boot (shared with the Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint32 data: the ticks since boot
+ *
+ ----------------------------------------------------------------------------------*/
+uint32 Get_uptimeTicks (void)
+{
+	uint32 ticks;
+	uint8 sreg = SREG;
+
+	cli();
+	ticks = g_uptimeTicks;
+	SREG = sreg;
+
+	return ticks;
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Get_ticks
+ *
+ * [Description]:  Function that reads the ticks since the last Reset_ticks (shared with the
+ * 					Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint32 data: the ticks since the last reset
+ *
+ ----------------------------------------------------------------------------------*/
+uint32 Get_ticks (void)
+{
+	uint32 ticks;
+	uint8 sreg = SREG;
+
+	cli();
+	ticks = g_ticks;
+	SREG = sreg;
+
+	return ticks;
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Reset_ticks
+ *
+ * [Description]:  Function that starts counting the ticks from zero (shared with the Timer1
+ * 					call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Reset_ticks (void)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	g_ticks = 0;
+	SREG = sreg;
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Send_lockoutState
+ *
+ * [Description]:  Function that tells the HMI ECU the passwords are locked out and for how long
+ *
+ * [Args]:         seconds: remaining lockout time
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Send_lockoutState (uint16 seconds)
+{
+	UART_sendByte(Danger);
+	UART_sendByte((uint8)(seconds >> 8));
+	UART_sendByte((uint8)seconds);
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Record_auditEvent
+ *
+ * [Description]:  Function that appends an event of the user to the audit log
+ * 					stamped with the seconds since boot
+ *
+ * [Args]:         event: one of AUDIT_EventType
+ * 				   result: event result
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Record_auditEvent (AUDIT_EventType event, uint8 result)
+{
+	AUDIT_append(event, AUDIT_DEFAULT_USER, result, Get_uptimeTicks() / TICKS_PER_SECOND);
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Setting_password_CTRL
+ *
+ * [Description]:  Function that gets the passwords from the user
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Setting_password_CTRL (void)
+{
+	/*
+	 *  FirstPassword: initialized password
+	 *  SecondPassword: confirmation of password
+	 */
+	uint8 FirstPassword[PASSWORD_LENGTH];
+	uint8 SecondPassword[PASSWORD_LENGTH];
+
+	/*
+	 * variable used to store the state of 2 passwords received by from HMI ECU
+	 * can only be 2 cases:
+	 * 						1- PASSWORD_MATCH
+	 * 						2- PASSWORD_UNMATCH
+	 */
+	uint8 Password_State = PASSWORD_UNMATCH;
+
+	while(Password_State == PASSWORD_UNMATCH)
+	{
+		/*communications between the 2 ECUs to check if they are ready to synchronize  */
+		while (UART_recieveByte() != READY);
+		UART_sendByte(READY);
+		/*
+		 * receive first password from HMI ECU  to compare it
+		 *  with the confirmed password to check Matching
+		 */
+		Receive_password_from_HMI_ECU(FirstPassword);
+
+		while (UART_recieveByte() != READY);
+		UART_sendByte(READY);
+
+		/*
+		 * receive confirmed password from HMI ECU  to compare it
+		 *  with the first password to check Matching
+		 */
+		Receive_password_from_HMI_ECU(SecondPassword);
+
+		/*
+		 * compare the two passwords to check the matching state
+		 */
+		Password_State = Compare_passwords(FirstPassword, SecondPassword);
+
+		UART_sendByte(READY);
+
+		UART_sendByte(Password_State);
+
+		if ( Password_State == PASSOWRD_MATCH)
+		{
+			/*
+			 * in case of matching: save to EEPROM
+			 */
+			Save_passwordToEEPROM(FirstPassword);
+			Buzzer_play(BUZZER_SUCCESS);
+		}
+	}
+}
+/*---------------------------------------------------------------------------
+ * [Function Name]: Timer_callBack
+ *
+ * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+
+void Timer_callBack (void)
+{
+	g_ticks++;
+	g_uptimeTicks++;
+
+	if ((g_alarmOn == TRUE) && ((g_uptimeTicks - g_alarmStart) >= DANGER_TIME))
+	{
+		g_alarmOn = FALSE;
+		Buzzer_stop();
+	}
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Motor_faultCallBack
+ *
+ * [Description]:  Function to be used by the current monitor after a stall or an overcurrent
+ * 					stopped the motor, ends the door movement at once
+ *
+ * [Args]:         fault: the detected fault
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Motor_faultCallBack (CURRENT_FaultType fault)
+{
+	DOOR_stop();
+}
+/*
+ * Description :
+ * Move the door to an end stop and report the open percentage to the HMI ECU every
+ * DOOR_REPORT_TIME while it changes. The door is stopped if the end stop is not reached
+ * in timeout ticks or by the current monitor. Returns SUCCESS at the end stop, ERROR otherwise.
+ */
+static uint8 Door_travel(DOOR_TargetType target, uint16 timeout)
+{
+	uint8 percent, reported = 0xFF;
+	uint32 ticks, nextReport = 0;
+
+	Reset_ticks();
+	CURRENT_clearFault();
+	DOOR_move(target);
+	while ((DOOR_getState() == DOOR_MOVING) && ((ticks = Get_ticks()) < timeout))
+	{
+		percent = DOOR_getOpenPercent();
+		if ((ticks >= nextReport) && (percent != reported))
+		{
+			UART_sendByte(DOOR_PROGRESS_REPORT);
+			UART_sendByte(percent);
+			reported = percent;
+			nextReport = ticks + DOOR_REPORT_TIME;
+		}
+	}
+	/* timeout: the fault guard stops the motor */
+	DOOR_stop();
+	/* stopped by the current monitor: keep the cause */
+	if (CURRENT_getFault() != CURRENT_NO_FAULT)
+	{
+		Record_auditEvent(AUDIT_EVENT_MOTOR_FAULT, CURRENT_getFault());
+	}
+
+	return (DOOR_getState() == DOOR_AT_TARGET) ? SUCCESS : ERROR;
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Door_tasksCTRL
+ *
+ * [Description]:  Function to open the door, hold it open and lock it again, every movement
+ * 					ends at its end stop and is reported to the HMI ECU
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Door_tasksCTRL(void)
+{
+	/*
+	 * open the door, the HMI ECU shows the progress until the open end stop
+	 */
+	if (Door_travel(DOOR_OPEN, DOOR_OPENNING_TIME) == SUCCESS)
+	{
+		UART_sendByte(DOOR_REACHED_OPEN);
+	}
+	else
+	{
+		UART_sendByte(DOOR_JAMMED);
+		Record_auditEvent(AUDIT_EVENT_DOOR_FAULT, DOOR_OPEN);
+	}
+
+	/*
+	 * make g_ticks zero to start calculation and comparison of time
+	 */
+	Reset_ticks();
+	/*
+	 * wait until door next state
+	 */
+	while (Get_ticks() < DOOR_LEFT_OPEN_TIME);
+
+	/*
+	 * lock the door again, also after a jammed opening
+	 */
+	if (Door_travel(DOOR_CLOSED, DOOR_CLOSING_TIME) == SUCCESS)
+	{
+		UART_sendByte(DOOR_REACHED_CLOSED);
+	}
+	else
+	{
+		UART_sendByte(DOOR_JAMMED);
+		Record_auditEvent(AUDIT_EVENT_DOOR_FAULT, DOOR_CLOSED);
+	}
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: dangerMission
+ *
+ * [Description]:  Function to start the danger state after too many un-matched passwords:
+ * 					tell the HMI ECU the lockout time and sound the alarm in the background,
+ * 					the Timer1 call back stops it after DANGER_TIME
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void dangerMission(void)
+{
+	uint8 sreg;
+
+	Send_lockoutState(LOCKOUT_getRemainingSeconds(Get_uptimeTicks()));
+
+	sreg = SREG;
+	cli();
+	g_alarmStart = g_uptimeTicks;
+	g_alarmOn = TRUE;
+	SREG = sreg;
+	Buzzer_play(BUZZER_ALARM);
+}
@@ -1,137 +1,251 @@
-/******************************************************************************
- *
- * Module: Control ECU supporting functions
- *
- * File Name: CTRL_supportingFunctions.h
- *
- * Description: Functions than are implemented in the Control ECU main function
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-#ifndef CTRL_SUPPORTINGFUNCTIONS_H_
-#define CTRL_SUPPORTINGFUNCTIONS_H_
-
-#include "std_types.h"
-#include "uart.h"
-#include "util/delay.h"
-#include "avr/io.h"
-#include "twi.h"
-#include "external_eeprom.h"
-#include "dc_motor.h"
-#include "buzzer.h"
-#include "timer.h"
-/*------------------------------------------------------------------------------
- *                              Definitions                                 	*
---------------------------------------------------------------------------------*/
-/*Password related definitions*/
-#define PASSWORD_LENGTH  					 5
-#define PASSOWRD_MATCH    					 1
-#define PASSWORD_UNMATCH  					 0
-#define ENTER_ASCII		 				    13
-#define NUMBER_OF_WRONG_PASSWORD_ATTEMPTS 	 3
-/*To communicate with Control ECU*/
-#define Opening_Door_Action				    0x88
-#define Changing_Password_Action		    0x44
-#define READY 								0x10
-#define Danger 								0x33
-/*Door options*/
-#define OPEN_DOOR_OPTION					'+'
-#define CHANGE_PASSWORD_OPTION				'-'
-
-/*Timing*/
-#define DOOR_OPENNING_TIME				    1788 //15sec
-#define DOOR_CLOSING_TIME				    1788 //15sec
-#define DOOR_LEFT_OPEN_TIME	 			    357 //3sec
-#define KEYPAD_PRESSED_TIME				    500
-#define DANGER_TIME						 	7152 //60sec
-#define EEPROM_STORE_ADDREESS		   	    0x00
-
-/*------------------------------------------------------------------------------
- *                              Global Variables                                *
---------------------------------------------------------------------------------*/
-extern uint32 g_ticks;
-extern uint8 g_password[PASSWORD_LENGTH];
-/*--------------------------------------------------------------------------
- *                       Functions Prototypes                            *
-----------------------------------------------------------------------------*/
-/*---------------------------------------------------------------------------
- * [Function Name]: Receive_password_from_HMI_ECU
- *
- * [Description]:  Function that receives the password fro the HMI ECU via UART
- *
- * [Args]:         password: a pointer to uint8 data
- *
- * [Returns]:      Void
- *
-  ----------------------------------------------------------------------------------*/
-void Receive_password_from_HMI_ECU (uint8 * password);
-/*---------------------------------------------------------------------------
- * [Function Name]: Compare_passwords
- *
- * [Description]:  Function that compares the passwords received fron the HMI ECU
- *
- * [Args]:         password1,password2:  pointers to uint8 data
- *
- * [Returns]:      uint8 data: indicated the passwords status
- *
-  ----------------------------------------------------------------------------------*/
-uint8 Compare_passwords (uint8 *password1, uint8 *password2);
-/*---------------------------------------------------------------------------
- * [Function Name]: Save_passwordToEEPROM
- *
- * [Description]:  Function that saves the password in case they are matched
- *
- * [Args]:         password: a pointer to uint8 data
- *
- * [Returns]:      Void
- *
-  ----------------------------------------------------------------------------------*/
-void Save_passwordToEEPROM (uint8 *password);
-/*---------------------------------------------------------------------------
- * [Function Name]: Setting_password_CTRL
- *
- * [Description]:  Function that gets the passwords from the user
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Setting_password_CTRL (void);
-/*---------------------------------------------------------------------------
- * [Function Name]: Timer_callBack
- *
- * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-
-void Timer_callBack (void);
-/*-------------------------------------------------------------------------------
- * [Function Name]: Door_tasksCTRL
- *
- * [Description]:  Function to display door state
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Door_tasksCTRL(void);
-/*-------------------------------------------------------------------------------
- * [Function Name]: dangerAlert
- *
- * [Description]:  Function to display a msg in case of un-matched passwords
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void dangerMission(void);
-
-#endif /* CTRL_SUPPORTINGFUNCTIONS_H_ */
+/******************************************************************************
+ *
+ * Module: Control ECU supporting functions
+ *
+ * File Name: CTRL_supportingFunctions.h
+ *
+ * Description: Functions than are implemented in the Control ECU main function
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+#ifndef CTRL_SUPPORTINGFUNCTIONS_H_
+#define CTRL_SUPPORTINGFUNCTIONS_H_
+
+#include "std_types.h"
+#include "uart.h"
+#include "util/delay.h"
+#include "avr/io.h"
+#include <avr/interrupt.h>
+#include "twi.h"
+#include "external_eeprom.h"
+#include "log_storage.h"
+#include "credential_storage.h"
+#include "audit_log.h"
+#include "dc_motor.h"
+#include "door_position.h"
+#include "current_monitor.h"
+#include "buzzer.h"
+#include "lockout.h"
+#include "timer.h"
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+/*Password related definitions*/
+#define PASSWORD_LENGTH  					 CREDENTIAL_LENGTH
+#define PASSOWRD_MATCH    					 1
+#define PASSWORD_UNMATCH  					 0
+#define ENTER_ASCII		 				    13
+#define NUMBER_OF_WRONG_PASSWORD_ATTEMPTS 	 LOCKOUT_MAX_FAILURES
+/*To communicate with Control ECU*/
+#define Opening_Door_Action				    0x88
+#define Changing_Password_Action		    0x44
+/*the audit log follows this reply (same stream as AUDIT_DUMP_REQUEST)*/
+#define Audit_Summary_Action				0x22
+#define READY 								0x10
+/*Lockout: Danger is followed by the remaining lockout seconds (high byte first)*/
+#define Danger 								0x33
+/*Boot handshake: HMI asks whether a password is already saved*/
+#define PASSWORD_STATUS_REQUEST				0x55
+#define PASSWORD_SAVED						0x66
+#define PASSWORD_NOT_SAVED					0x77
+/*the EEPROM does not answer: the password is unknown, the HMI asks again later*/
+#define STORAGE_FAULT						0x78
+/*Service request: stream the audit log ring*/
+#define AUDIT_DUMP_REQUEST					0x5A
+/*Door movement reports to the HMI ECU, a progress report is followed by the open percentage*/
+#define DOOR_PROGRESS_REPORT				0x9A
+#define DOOR_REACHED_OPEN					0x9B
+#define DOOR_REACHED_CLOSED					0x9C
+#define DOOR_JAMMED							0x9D
+/*Door options*/
+#define OPEN_DOOR_OPTION					'+'
+#define CHANGE_PASSWORD_OPTION				'-'
+#define AUDIT_SUMMARY_OPTION				'*'
+
+/*Timing, in Timer1 ticks (see TICKS_PER_SECOND in timer.h)*/
+/*the door stops at its end stops, these are the fault guards of the movements*/
+#define DOOR_OPENNING_TIME				    SECONDS_TO_TICKS(15)
+#define DOOR_CLOSING_TIME				    SECONDS_TO_TICKS(15)
+#define DOOR_REPORT_TIME					MS_TO_TICKS(100)
+#define DOOR_LEFT_OPEN_TIME	 			    SECONDS_TO_TICKS(3)
+#define KEYPAD_PRESSED_TIME				    500
+#define DANGER_TIME						 	SECONDS_TO_TICKS(60) //alarm when a lockout starts
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+extern volatile uint32 g_ticks;
+extern volatile uint32 g_uptimeTicks;
+extern uint8 g_password[PASSWORD_LENGTH];
+/*--------------------------------------------------------------------------
+ *                       Functions Prototypes                            *
+----------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------
+ * [Function Name]: Receive_password_from_HMI_ECU
+ *
+ * [Description]:  Function that receives the password fro the HMI ECU via UART
+ *
+ * [Args]:         password: a pointer to uint8 data
+ *
+ * [Returns]:      Void
+ *
+  ----------------------------------------------------------------------------------*/
+void Receive_password_from_HMI_ECU (uint8 * password);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Compare_passwords
+ *
+ * [Description]:  Function that compares the passwords received fron the HMI ECU
+ *
+ * [Args]:         password1,password2:  pointers to uint8 data
+ *
+ * [Returns]:      uint8 data: indicated the passwords status
+ *
+  ----------------------------------------------------------------------------------*/
+uint8 Compare_passwords (uint8 *password1, uint8 *password2);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Save_passwordToEEPROM
+ *
+ * [Description]:  Function that saves the password in case they are matched
+ * 					as a new credential record (see credential_storage.h)
+ *
+ * [Args]:         password: a pointer to uint8 data
+ *
+ * [Returns]:      Void
+ *
+  ----------------------------------------------------------------------------------*/
+void Save_passwordToEEPROM (uint8 *password);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Load_storage
+ *
+ * [Description]:  Function that rebuilds the log storage index, the audit log ring and the
+ * 					lockout state from the EEPROM and loads the saved password
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint8 data: SUCCESS, CREDENTIAL_NOT_SAVED or ERROR in case of EEPROM
+ * 					communication failure (see CREDENTIAL_load)
+ *
+   ----------------------------------------------------------------------------------*/
+uint8 Load_storage (void);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Get_uptimeTicks
+ *
+ * [Description]:  Function that reads the ticks since boot (shared with the Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint32 data: the ticks since boot
+ *
+  ----------------------------------------------------------------------------------*/
+uint32 Get_uptimeTicks (void);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Get_ticks
+ *
+ * [Description]:  Function that reads the ticks since the last Reset_ticks (shared with the
+ * 					Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint32 data: the ticks since the last reset
+ *
+ ----------------------------------------------------------------------------------*/
+uint32 Get_ticks (void);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Reset_ticks
+ *
+ * [Description]:  Function that starts counting the ticks from zero (shared with the Timer1
+ * 					call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Reset_ticks (void);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Send_lockoutState
+ *
+ * [Description]:  Function that tells the HMI ECU the passwords are locked out and for how long
+ * 					(Danger then the remaining seconds, high byte first)
+ *
+ * [Args]:         seconds: remaining lockout time
+ *
+ * [Returns]:      Void
+ *
+  ----------------------------------------------------------------------------------*/
+void Send_lockoutState (uint16 seconds);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Record_auditEvent
+ *
+ * [Description]:  Function that appends an event of the user to the audit log
+ * 					stamped with the seconds since boot
+ *
+ * [Args]:         event: one of AUDIT_EventType
+ * 				   result: event result
+ *
+ * [Returns]:      Void
+ *
+  ----------------------------------------------------------------------------------*/
+void Record_auditEvent (AUDIT_EventType event, uint8 result);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Setting_password_CTRL
+ *
+ * [Description]:  Function that gets the passwords from the user
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Setting_password_CTRL (void);
+/*---------------------------------------------------------------------------
+ * [Function Name]: Timer_callBack
+ *
+ * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+
+void Timer_callBack (void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Motor_faultCallBack
+ *
+ * [Description]:  Function to be used by the current monitor after a stall or an overcurrent
+ * 					stopped the motor, ends the door movement at once
+ *
+ * [Args]:         fault: the detected fault
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Motor_faultCallBack (CURRENT_FaultType fault);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Door_tasksCTRL
+ *
+ * [Description]:  Function to open the door, hold it open and lock it again, every movement
+ * 					ends at its end stop and is reported to the HMI ECU
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Door_tasksCTRL(void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: dangerMission
+ *
+ * [Description]:  Function to start the danger state after too many un-matched passwords:
+ * 					tell the HMI ECU the lockout time and sound the alarm in the background
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void dangerMission(void);
+
+#endif /* CTRL_SUPPORTINGFUNCTIONS_H_ */
@@ -0,0 +1,77 @@
+/******************************************************************************
+ *
+ * Module: CRC16
+ *
+ * File Name: crc16.c
+ *
+ * Description: Source file for the CRC-16/CCITT and CRC-8 checksums used by the persistent records
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "crc16.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CRC16_update
+ *
+ * [Description]:  Function to continue a CRC-16/CCITT calculation over a block of bytes
+ *
+ * [Args]:        crc: the CRC value so far (CRC16_INITIAL_VALUE for a new calculation)
+ * 				  data: a pointer to the bytes to be added
+ * 				  length: number of bytes
+ *
+ * [Returns]:      the updated CRC value
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 CRC16_update(uint16 crc, const uint8 *data, uint16 length)
+{
+	uint8 bit;
+
+	while (length--)
+	{
+		crc ^= (uint16)(*data++) << 8;
+		/* bitwise form: no table, the records are a few bytes long */
+		for (bit = 0; bit < 8; bit++)
+		{
+			if (crc & 0x8000)
+				crc = (crc << 1) ^ CRC16_POLYNOMIAL;
+			else
+				crc <<= 1;
+		}
+	}
+	return crc;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CRC8_update
+ *
+ * [Description]:  Function to continue a CRC-8 calculation over a block of bytes
+ *
+ * [Args]:        crc: the CRC value so far (CRC8_INITIAL_VALUE for a new calculation)
+ * 				  data: a pointer to the bytes to be added
+ * 				  length: number of bytes
+ *
+ * [Returns]:      the updated CRC value
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 CRC8_update(uint8 crc, const uint8 *data, uint16 length)
+{
+	uint8 bit;
+
+	while (length--)
+	{
+		crc ^= *data++;
+		for (bit = 0; bit < 8; bit++)
+		{
+			if (crc & 0x80)
+				crc = (crc << 1) ^ CRC8_POLYNOMIAL;
+			else
+				crc <<= 1;
+		}
+	}
+	return crc;
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ *
+ * Module: CRC16
+ *
+ * File Name: crc16.h
+ *
+ * Description: Header file for the CRC-16/CCITT and CRC-8 checksums used by the persistent records
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include "std_types.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+#define CRC16_INITIAL_VALUE		0xFFFF
+#define CRC16_POLYNOMIAL		0x1021
+
+/* CRC-8 (polynomial x^8+x^2+x+1) of the records too small for a CRC-16 */
+#define CRC8_INITIAL_VALUE		0xFF
+#define CRC8_POLYNOMIAL			0x07
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CRC16_update
+ *
+ * [Description]:  Function to continue a CRC-16/CCITT calculation over a block of bytes
+ *
+ * [Args]:        crc: the CRC value so far (CRC16_INITIAL_VALUE for a new calculation)
+ * 				  data: a pointer to the bytes to be added
+ * 				  length: number of bytes
+ *
+ * [Returns]:      the updated CRC value
+ *
+ ----------------------------------------------------------------------------------*/
+uint16 CRC16_update(uint16 crc, const uint8 *data, uint16 length);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: CRC8_update
+ *
+ * [Description]:  Function to continue a CRC-8 calculation over a block of bytes
+ *
+ * [Args]:        crc: the CRC value so far (CRC8_INITIAL_VALUE for a new calculation)
+ * 				  data: a pointer to the bytes to be added
+ * 				  length: number of bytes
+ *
+ * [Returns]:      the updated CRC value
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 CRC8_update(uint8 crc, const uint8 *data, uint16 length);
+
+#endif /* CRC16_H_ */
@@ -0,0 +1,214 @@
+/******************************************************************************
+ *
+ * Module: Host simulation
+ *
+ * File Name: format_bench.c
+ *
+ * Description: Native Linux check and cycle-count benchmark of the number formatting
+ * 				(num_format.c) against a division-based itoa
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "num_format.h"
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+#define BENCH_ROUNDS				20
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+/* read through a volatile so the host compiler can not turn the division into a multiplication */
+static volatile uint16 g_radix = 10;
+
+/* keeps the results alive so the formatting is not optimized away */
+static volatile uint8 g_sink;
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+/*
+ * The ATmega16 has no divide instruction, avr-gcc calls __udivmodhi4: a 16 steps
+ * shift-and-subtract loop. The same loop here gives the host the cost structure of the
+ * target; the host hardware division is also measured for comparison.
+ */
+static uint16 BENCH_udivmod(uint16 dividend, uint16 divisor, uint16 *remainder)
+{
+	uint16 rest = 0;
+	uint8 bit;
+
+	for (bit = 0; bit < 16; bit++)
+	{
+		rest = (rest << 1) | (dividend >> 15);
+		dividend <<= 1;
+		if (rest >= divisor)
+		{
+			rest -= divisor;
+			dividend |= 1;
+		}
+	}
+	*remainder = rest;
+	return dividend;
+}
+
+/* same algorithm as the avr-libc itoa: one division per digit, then reverse */
+static char *BENCH_itoa(int value, char *buffer, uint16 radix, boolean softDivision)
+{
+	uint16 magnitude = (value < 0) ? (uint16)0 - (uint16)value : (uint16)value;
+	uint16 digit;
+	char *p = buffer, *q;
+	char c;
+
+	do
+	{
+		if (softDivision)
+		{
+			magnitude = BENCH_udivmod(magnitude, radix, &digit);
+		}
+		else
+		{
+			digit = magnitude % radix;
+			magnitude /= radix;
+		}
+		*p++ = '0' + (char)digit;
+	} while (magnitude);
+	if (value < 0)
+	{
+		*p++ = '-';
+	}
+	*p = '\0';
+	for (q = buffer, p--; q < p; q++, p--)
+	{
+		c = *q;
+		*q = *p;
+		*p = c;
+	}
+	return buffer;
+}
+
+static unsigned long long BENCH_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	struct timespec now;
+
+	/* no cycle counter: nanoseconds */
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long)now.tv_sec * 1000000000ULL + now.tv_nsec;
+#endif
+}
+
+static int BENCH_check(void)
+{
+	char expected[16], buffer[FORMAT_BUFFER_SIZE + 4];
+	long value;
+	int errors = 0;
+
+	for (value = 0; value <= 65535; value++)
+	{
+		snprintf(expected, sizeof(expected), "%lu", (unsigned long)value);
+		FORMAT_unsigned(buffer, (uint16)value, 0, FORMAT_PAD_ZERO);
+		errors += (strcmp(expected, buffer) != 0);
+
+		snprintf(expected, sizeof(expected), "%05lu", (unsigned long)value);
+		FORMAT_unsigned(buffer, (uint16)value, 5, FORMAT_PAD_ZERO);
+		errors += (strcmp(expected, buffer) != 0);
+
+		snprintf(expected, sizeof(expected), "%7lu", (unsigned long)value);
+		FORMAT_unsigned(buffer, (uint16)value, 7, FORMAT_PAD_SPACE);
+		errors += (strcmp(expected, buffer) != 0);
+
+		snprintf(expected, sizeof(expected), "%02lu:%02lu", (unsigned long)value / 60,
+				 (unsigned long)value % 60);
+		FORMAT_mmss(buffer, (uint16)value);
+		errors += (strcmp(expected, buffer) != 0);
+	}
+	for (value = -32768; value <= 32767; value++)
+	{
+		snprintf(expected, sizeof(expected), "%ld", value);
+		errors += (strcmp(expected, BENCH_itoa((int)value, buffer, 10, TRUE)) != 0);
+		errors += (strcmp(expected, BENCH_itoa((int)value, buffer, 10, FALSE)) != 0);
+		FORMAT_signed(buffer, (sint16)value, 0, FORMAT_PAD_SPACE);
+		errors += (strcmp(expected, buffer) != 0);
+
+		snprintf(expected, sizeof(expected), "%06ld", value);
+		FORMAT_signed(buffer, (sint16)value, 6, FORMAT_PAD_ZERO);
+		errors += (strcmp(expected, buffer) != 0);
+
+		snprintf(expected, sizeof(expected), "%6ld", value);
+		FORMAT_signed(buffer, (sint16)value, 6, FORMAT_PAD_SPACE);
+		errors += (strcmp(expected, buffer) != 0);
+	}
+	return errors;
+}
+
+static void BENCH_report(const char *name, unsigned long long cycles, unsigned long calls)
+{
+	printf("%-32s %10.1f %s/call\n", name, (double)cycles / calls,
+#if defined(__x86_64__) || defined(__i386__)
+		   "cycles"
+#else
+		   "ns"
+#endif
+		   );
+}
+
+int main(void)
+{
+	char buffer[FORMAT_BUFFER_SIZE];
+	unsigned long long start, itoaCycles = 0, hostItoaCycles = 0, formatCycles = 0, mmssCycles = 0;
+	unsigned long calls = 0;
+	uint16 value;
+	uint8 round;
+	int errors;
+
+	errors = BENCH_check();
+	printf("format check: %d mismatches\n", errors);
+
+	for (round = 0; round < BENCH_ROUNDS; round++)
+	{
+		value = 0;
+		start = BENCH_cycles();
+		do
+		{
+			g_sink = BENCH_itoa(value, buffer, g_radix, TRUE)[0];
+		} while (++value);
+		itoaCycles += BENCH_cycles() - start;
+
+		start = BENCH_cycles();
+		do
+		{
+			g_sink = BENCH_itoa(value, buffer, g_radix, FALSE)[0];
+		} while (++value);
+		hostItoaCycles += BENCH_cycles() - start;
+
+		start = BENCH_cycles();
+		do
+		{
+			g_sink = FORMAT_unsigned(buffer, value, 0, FORMAT_PAD_ZERO);
+		} while (++value);
+		formatCycles += BENCH_cycles() - start;
+
+		start = BENCH_cycles();
+		do
+		{
+			g_sink = FORMAT_mmss(buffer, value);
+		} while (++value);
+		mmssCycles += BENCH_cycles() - start;
+
+		calls += 65536UL;
+	}
+	BENCH_report("itoa (AVR software division)", itoaCycles, calls);
+	BENCH_report("itoa (host hardware division)", hostItoaCycles, calls);
+	BENCH_report("FORMAT_unsigned", formatCycles, calls);
+	BENCH_report("FORMAT_mmss", mmssCycles, calls);
+
+	return (errors == 0) ? 0 : 1;
+}
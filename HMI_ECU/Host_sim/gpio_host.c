@@ -0,0 +1,193 @@
+/******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: gpio_host.c
+ *
+ * Description: Source file for the host backend of the GPIO driver: the firmware
+ * 				gpio.c runs on the port register variables and every access (also of
+ * 				the static pin API) is reported to the device model connected to the pins
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <avr/io.h>
+#include "gpio_host.h"
+#include "host_clock.h"
+
+/*
+ * The register level driver is built unchanged under other names, the functions of
+ * the GPIO API below wrap it with the simulated time and the device notification.
+ */
+#define GPIO_setupPinDirection		GPIO_HW_setupPinDirection
+#define GPIO_writePin				GPIO_HW_writePin
+#define GPIO_readPin				GPIO_HW_readPin
+#define GPIO_setupPortDirection		GPIO_HW_setupPortDirection
+#define GPIO_writePort				GPIO_HW_writePort
+#define GPIO_readPort				GPIO_HW_readPort
+#define GPIO_writePortMasked		GPIO_HW_writePortMasked
+#define GPIO_togglePins				GPIO_HW_togglePins
+#include "gpio.c"
+#undef GPIO_setupPinDirection
+#undef GPIO_writePin
+#undef GPIO_readPin
+#undef GPIO_setupPortDirection
+#undef GPIO_writePort
+#undef GPIO_readPort
+#undef GPIO_writePortMasked
+#undef GPIO_togglePins
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+volatile unsigned char PORTA, DDRA, PINA;
+volatile unsigned char PORTB, DDRB, PINB;
+volatile unsigned char PORTC, DDRC, PINC;
+volatile unsigned char PORTD, DDRD, PIND;
+volatile unsigned char SREG;
+
+static volatile unsigned char * const g_portRegs[NUM_OF_PORTS] = {&PORTA, &PORTB, &PORTC, &PORTD};
+static volatile unsigned char * const g_ddrRegs[NUM_OF_PORTS] = {&DDRA, &DDRB, &DDRC, &DDRD};
+static volatile unsigned char * const g_pinRegs[NUM_OF_PORTS] = {&PINA, &PINB, &PINC, &PIND};
+
+/* pins driven by the device model and their levels */
+static uint8 g_driveMask[NUM_OF_PORTS];
+static uint8 g_driveValue[NUM_OF_PORTS];
+
+static void (*g_callBackPtr)(HOST_GPIO_AccessType access) = NULL_PTR;
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+static void HOST_GPIO_notify(HOST_GPIO_AccessType access)
+{
+	if (g_callBackPtr != NULL_PTR)
+	{
+		(*g_callBackPtr)(access);
+	}
+}
+
+/* the pins change at the end of the call */
+static void HOST_GPIO_written(uint64 costNs)
+{
+	HOST_CLOCK_advanceNs(costNs);
+	HOST_GPIO_notify(HOST_GPIO_PINS_WRITTEN);
+}
+
+/* the pins are sampled at the end of the call */
+static void HOST_GPIO_sample(uint8 port_num, uint64 costNs)
+{
+	HOST_CLOCK_advanceNs(costNs);
+	HOST_GPIO_notify(HOST_GPIO_PINS_READ);
+	if (port_num < NUM_OF_PORTS)
+	{
+		*g_pinRegs[port_num] = HOST_GPIO_getPortLevel(port_num);
+	}
+}
+
+void HOST_GPIO_init(void)
+{
+	uint8 port;
+
+	for (port = 0; port < NUM_OF_PORTS; port++)
+	{
+		*g_portRegs[port] = 0;
+		*g_ddrRegs[port] = 0;
+		*g_pinRegs[port] = 0;
+		g_driveMask[port] = 0;
+		g_driveValue[port] = 0;
+	}
+}
+
+void HOST_GPIO_staticWritten(void)
+{
+	HOST_GPIO_written(HOST_GPIO_STATIC_WRITE_NS);
+}
+
+void HOST_GPIO_staticRead(unsigned char port_num)
+{
+	HOST_GPIO_sample(port_num, HOST_GPIO_STATIC_READ_NS);
+}
+
+void HOST_GPIO_setCallBack(void(*a_ptr)(HOST_GPIO_AccessType access))
+{
+	g_callBackPtr = a_ptr;
+}
+
+void HOST_GPIO_drive(uint8 port_num, uint8 mask, uint8 value)
+{
+	if (port_num < NUM_OF_PORTS)
+	{
+		g_driveMask[port_num] = mask;
+		g_driveValue[port_num] = value & mask;
+	}
+}
+
+uint8 HOST_GPIO_getPortLevel(uint8 port_num)
+{
+	uint8 outputs, driven;
+
+	if (port_num >= NUM_OF_PORTS)
+	{
+		return 0;
+	}
+	outputs = *g_ddrRegs[port_num];
+	driven = g_driveMask[port_num] & ~outputs;
+	/* an input pin that nobody drives reads its pull-up (PORT bit) */
+	return (*g_portRegs[port_num] & outputs) | (g_driveValue[port_num] & driven) |
+		   (*g_portRegs[port_num] & ~outputs & ~driven);
+}
+
+uint8 HOST_GPIO_getPortDirection(uint8 port_num)
+{
+	return (port_num < NUM_OF_PORTS) ? *g_ddrRegs[port_num] : 0;
+}
+
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction)
+{
+	GPIO_HW_setupPinDirection(port_num, pin_num, direction);
+	HOST_GPIO_written(HOST_GPIO_CALL_NS);
+}
+
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value)
+{
+	GPIO_HW_writePin(port_num, pin_num, value);
+	HOST_GPIO_written(HOST_GPIO_CALL_NS);
+}
+
+uint8 GPIO_readPin(uint8 port_num, uint8 pin_num)
+{
+	HOST_GPIO_sample(port_num, HOST_GPIO_CALL_NS);
+	return GPIO_HW_readPin(port_num, pin_num);
+}
+
+void GPIO_setupPortDirection(uint8 port_num, uint8 direction)
+{
+	GPIO_HW_setupPortDirection(port_num, direction);
+	HOST_GPIO_written(HOST_GPIO_CALL_NS);
+}
+
+void GPIO_writePort(uint8 port_num, uint8 value)
+{
+	GPIO_HW_writePort(port_num, value);
+	HOST_GPIO_written(HOST_GPIO_CALL_NS);
+}
+
+uint8 GPIO_readPort(uint8 port_num)
+{
+	HOST_GPIO_sample(port_num, HOST_GPIO_CALL_NS);
+	return GPIO_HW_readPort(port_num);
+}
+
+void GPIO_writePortMasked(uint8 port_num, uint8 mask, uint8 value)
+{
+	GPIO_HW_writePortMasked(port_num, mask, value);
+	HOST_GPIO_written(HOST_GPIO_CALL_NS);
+}
+
+void GPIO_togglePins(uint8 port_num, uint8 mask)
+{
+	GPIO_HW_togglePins(port_num, mask);
+	HOST_GPIO_written(HOST_GPIO_CALL_NS);
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: gpio_host.h
+ *
+ * Description: Header file for the host backend of the GPIO driver: the firmware
+ * 				gpio.c runs on the port register variables and every access (also of
+ * 				the static pin API) is reported to the device model connected to the pins
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_HOST_H_
+#define GPIO_HOST_H_
+
+#include "std_types.h"
+#include "gpio.h"
+
+#ifndef F_CPU
+#define F_CPU 8000000UL
+#endif
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+/*
+ * Simulated cost of one GPIO driver call (call, port switch, read-modify-write and
+ * return, about 24 cycles of the ATmega16), the pins change at the end of it
+ */
+#ifndef HOST_GPIO_CALL_CYCLES
+#define HOST_GPIO_CALL_CYCLES			24
+#endif
+#define HOST_GPIO_CALL_NS				((uint64)HOST_GPIO_CALL_CYCLES * 1000000000ULL / F_CPU)
+
+/* one access of the static pin API: SBI/CBI take 2 cycles, OUT and IN 1 */
+#define HOST_GPIO_STATIC_WRITE_NS		(2 * 1000000000ULL / F_CPU)
+#define HOST_GPIO_STATIC_READ_NS		(1000000000ULL / F_CPU)
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum
+{
+	HOST_GPIO_PINS_WRITTEN,HOST_GPIO_PINS_READ
+}HOST_GPIO_AccessType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*
+ * Description :
+ * Reset all the port registers (all pins input without pull-up) and the external drive.
+ */
+void HOST_GPIO_init(void);
+
+/*
+ * Description :
+ * Set the function called after every direction/output change and before every read,
+ * the device model samples the pins or drives its outputs from there.
+ */
+void HOST_GPIO_setCallBack(void(*a_ptr)(HOST_GPIO_AccessType access));
+
+/*
+ * Description :
+ * Hooks of the static pin API (see include/avr/io.h): a register was written directly,
+ * or a PIN register is about to be read.
+ */
+void HOST_GPIO_staticWritten(void);
+void HOST_GPIO_staticRead(unsigned char port_num);
+
+/*
+ * Description :
+ * Device side: drive the pins of mask with value, the other pins are released.
+ * A driven pin that is also an MCU output is a bus contention (the MCU level wins here).
+ */
+void HOST_GPIO_drive(uint8 port_num, uint8 mask, uint8 value);
+
+/*
+ * Description :
+ * Device side: return the level of every pin of a port (MCU output, device drive or
+ * the pull-up of an input pin, a floating pin reads Logic Low).
+ */
+uint8 HOST_GPIO_getPortLevel(uint8 port_num);
+
+/*
+ * Description :
+ * Device side: return the direction register of a port (1 = MCU output).
+ */
+uint8 HOST_GPIO_getPortDirection(uint8 port_num);
+
+#endif /* GPIO_HOST_H_ */
@@ -0,0 +1,533 @@
+/******************************************************************************
+ *
+ * Module: HD44780 model
+ *
+ * File Name: hd44780_model.c
+ *
+ * Description: Source file for the host model of the HD44780 character LCD controller,
+ * 				it decodes the RS/RW/E/data pins of the host GPIO backend, keeps the
+ * 				DDRAM and the CGRAM, checks the bus timing and records the screen frames
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <string.h>
+#include "hd44780_model.h"
+#include "gpio_host.h"
+#include "host_clock.h"
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+/* DDRAM address ranges of the two lines (two line mode) */
+#define MODEL_LINE_LENGTH				40
+#define MODEL_SECOND_LINE_ADDRESS		0x40
+#define MODEL_CGRAM_ADDRESS_MASK		0x3F
+#define MODEL_NO_TIME					0xFFFFFFFFFFFFFFFFULL
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static HD44780_MODEL_ConfigType g_config;
+static HD44780_MODEL_StatisticsType g_statistics;
+static void (*g_violationCallBackPtr)(HD44780_MODEL_ViolationType violation, uint64 timeNs) = NULL_PTR;
+
+static const char * const g_violationNames[HD44780_MODEL_NUM_OF_VIOLATIONS] =
+{
+	"RS/RW setup to E rise (tAS)", "RS/RW hold after E fall (tAH)", "E pulse width (PWEH)",
+	"E cycle time (tcycE)", "data setup to E fall (tDSW)", "data hold after E fall (tH)",
+	"data read before valid (tDDR)", "write while busy", "bus contention on a read",
+	"access during the power on reset"
+};
+
+/* controller registers */
+static uint8 g_ddram[HD44780_MODEL_DDRAM_SIZE];
+static uint8 g_cgram[HD44780_MODEL_CGRAM_SIZE];
+static uint8 g_addressCounter;
+static boolean g_inCgram;
+static boolean g_increment;
+static boolean g_shiftOnWrite;
+static boolean g_displayOn;
+static boolean g_eightBits;
+static boolean g_twoLines;
+static uint8 g_displayShift;
+static uint64 g_busyUntilNs;
+static uint64 g_powerOnNs;
+
+/* bus state: last sampled levels and when they changed */
+static uint8 g_rs, g_rw, g_e, g_data;
+static uint64 g_controlChangeNs, g_dataChangeNs, g_eRiseNs, g_eFallNs;
+/* 4-bit interface: TRUE when the next nibble is the low one, and the high nibble */
+static boolean g_lowNibbleNext;
+static uint8 g_highNibble;
+/* byte put on the bus by the current read */
+static uint8 g_readValue;
+static boolean g_contentionReported;
+
+static HD44780_MODEL_FrameType g_frames[HD44780_MODEL_MAX_FRAMES];
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+static void MODEL_violation(HD44780_MODEL_ViolationType violation)
+{
+	g_statistics.violations[violation]++;
+	if (g_violationCallBackPtr != NULL_PTR)
+	{
+		(*g_violationCallBackPtr)(violation, HOST_CLOCK_nowNs());
+	}
+}
+
+static uint8 MODEL_pinLevel(uint8 port_num, uint8 pin_num)
+{
+	return (HOST_GPIO_getPortLevel(port_num) >> pin_num) & 1;
+}
+
+/* data lines as a byte (8-bit wiring) or as the high nibble (D4-D7 wiring, D0-D3 low) */
+static uint8 MODEL_dataLevel(void)
+{
+	uint8 level = HOST_GPIO_getPortLevel(g_config.dataPort);
+
+	if (g_config.dataBits == 8)
+	{
+		return level;
+	}
+	return ((level >> g_config.firstDataPin) & 0x0F) << 4;
+}
+
+static uint8 MODEL_dataPinsMask(void)
+{
+	return (g_config.dataBits == 8) ? 0xFF : (uint8)(0x0F << g_config.firstDataPin);
+}
+
+/* index in g_ddram of a DDRAM address */
+static uint8 MODEL_ddramIndex(uint8 address)
+{
+	if (!g_twoLines)
+	{
+		return address % HD44780_MODEL_DDRAM_SIZE;
+	}
+	return ((address & MODEL_SECOND_LINE_ADDRESS) ? MODEL_LINE_LENGTH : 0) +
+		   ((address & ~MODEL_SECOND_LINE_ADDRESS) % MODEL_LINE_LENGTH);
+}
+
+/* DDRAM address of a visible cell, rows 2 and 3 continue the lines 0 and 1 */
+static uint8 MODEL_cellAddress(uint8 row, uint8 col)
+{
+	uint8 offset = ((row & 2) ? g_config.cols : 0) + col + g_displayShift;
+
+	if (!g_twoLines)
+	{
+		return (uint8)((row * g_config.cols + col + g_displayShift) % HD44780_MODEL_DDRAM_SIZE);
+	}
+	return ((row & 1) ? MODEL_SECOND_LINE_ADDRESS : 0) + (offset % MODEL_LINE_LENGTH);
+}
+
+static void MODEL_moveAddressCounter(boolean increment)
+{
+	if (g_inCgram)
+	{
+		g_addressCounter = (g_addressCounter + (increment ? 1 : -1)) & MODEL_CGRAM_ADDRESS_MASK;
+	}
+	else if (g_twoLines)
+	{
+		/* the address wraps from the end of a line to the start of the other one */
+		if (increment)
+			g_addressCounter = (g_addressCounter == 0x27) ? 0x40 : (g_addressCounter == 0x67) ? 0x00 : g_addressCounter + 1;
+		else
+			g_addressCounter = (g_addressCounter == 0x40) ? 0x27 : (g_addressCounter == 0x00) ? 0x67 : g_addressCounter - 1;
+	}
+	else
+	{
+		g_addressCounter = increment ? ((g_addressCounter + 1) % HD44780_MODEL_DDRAM_SIZE) :
+						   (g_addressCounter ? g_addressCounter - 1 : HD44780_MODEL_DDRAM_SIZE - 1);
+	}
+}
+
+static void MODEL_shiftDisplay(boolean right)
+{
+	uint8 length = g_twoLines ? MODEL_LINE_LENGTH : HD44780_MODEL_DDRAM_SIZE;
+
+	g_displayShift = right ? (g_displayShift + length - 1) % length : (g_displayShift + 1) % length;
+}
+
+/* record a frame if the visible cells differ from the last one */
+static void MODEL_recordFrame(void)
+{
+	HD44780_MODEL_FrameType frame;
+	const HD44780_MODEL_FrameType *last;
+
+	HD44780_MODEL_getScreen(&frame);
+	if (g_statistics.frames > 0)
+	{
+		last = &g_frames[(g_statistics.frames - 1) % HD44780_MODEL_MAX_FRAMES];
+		if (memcmp(last->cells, frame.cells, sizeof(frame.cells)) == 0)
+			return;
+	}
+	g_frames[g_statistics.frames % HD44780_MODEL_MAX_FRAMES] = frame;
+	g_statistics.frames++;
+}
+
+static void MODEL_instruction(uint8 instruction)
+{
+	uint64 execution = HD44780_MODEL_EXEC_NS;
+
+	g_statistics.instructions++;
+	if (instruction & 0x80)
+	{
+		/* set DDRAM address */
+		g_inCgram = FALSE;
+		g_addressCounter = instruction & 0x7F;
+	}
+	else if (instruction & 0x40)
+	{
+		/* set CGRAM address */
+		g_inCgram = TRUE;
+		g_addressCounter = instruction & MODEL_CGRAM_ADDRESS_MASK;
+	}
+	else if (instruction & 0x20)
+	{
+		/* function set: DL, N */
+		g_eightBits = (instruction & 0x10) ? TRUE : FALSE;
+		g_twoLines = (instruction & 0x08) ? TRUE : FALSE;
+		g_lowNibbleNext = FALSE;
+	}
+	else if (instruction & 0x10)
+	{
+		/* cursor or display shift: S/C, R/L */
+		if (instruction & 0x08)
+			MODEL_shiftDisplay((instruction & 0x04) ? TRUE : FALSE);
+		else
+			MODEL_moveAddressCounter((instruction & 0x04) ? TRUE : FALSE);
+	}
+	else if (instruction & 0x08)
+	{
+		/* display on/off control: D (the cursor and the blink are not shown in the frames) */
+		g_displayOn = (instruction & 0x04) ? TRUE : FALSE;
+	}
+	else if (instruction & 0x04)
+	{
+		/* entry mode set: I/D, S */
+		g_increment = (instruction & 0x02) ? TRUE : FALSE;
+		g_shiftOnWrite = (instruction & 0x01) ? TRUE : FALSE;
+	}
+	else if (instruction & 0x02)
+	{
+		/* return home */
+		g_inCgram = FALSE;
+		g_addressCounter = 0;
+		g_displayShift = 0;
+		execution = HD44780_MODEL_CLEAR_EXEC_NS;
+	}
+	else if (instruction & 0x01)
+	{
+		/* clear display */
+		memset(g_ddram, ' ', sizeof(g_ddram));
+		g_inCgram = FALSE;
+		g_addressCounter = 0;
+		g_displayShift = 0;
+		g_increment = TRUE;
+		execution = HD44780_MODEL_CLEAR_EXEC_NS;
+	}
+	else
+	{
+		/* 0x00 is no instruction: the first nibble of the 4-bit switch in 8-bit mode */
+		execution = 0;
+	}
+	g_busyUntilNs = HOST_CLOCK_nowNs() + execution;
+	MODEL_recordFrame();
+}
+
+static void MODEL_writeData(uint8 data)
+{
+	g_statistics.dataWrites++;
+	if (g_inCgram)
+	{
+		g_cgram[g_addressCounter] = data & 0x1F;
+	}
+	else
+	{
+		g_ddram[MODEL_ddramIndex(g_addressCounter)] = data;
+	}
+	MODEL_moveAddressCounter(g_increment);
+	if (g_shiftOnWrite && !g_inCgram)
+	{
+		MODEL_shiftDisplay(g_increment ? FALSE : TRUE);
+	}
+	g_busyUntilNs = HOST_CLOCK_nowNs() + HD44780_MODEL_EXEC_NS;
+	MODEL_recordFrame();
+}
+
+/* a complete byte was written (E fall of the only or of the low nibble) */
+static void MODEL_write(uint8 value)
+{
+	if (HOST_CLOCK_nowNs() < g_powerOnNs + HD44780_MODEL_POWER_ON_NS)
+	{
+		MODEL_violation(HD44780_MODEL_POWER_ON_RESET);
+		g_statistics.ignoredWrites++;
+		return;
+	}
+	if (HOST_CLOCK_nowNs() < g_busyUntilNs)
+	{
+		/* the controller ignores anything written while it executes */
+		MODEL_violation(HD44780_MODEL_WRITE_WHILE_BUSY);
+		g_statistics.ignoredWrites++;
+		return;
+	}
+	if (g_rs)
+		MODEL_writeData(value);
+	else
+		MODEL_instruction(value);
+}
+
+/* value put on the bus by a read at the E rise of its first (or only) transfer */
+static uint8 MODEL_readValue(void)
+{
+	uint8 value;
+
+	if (!g_rs)
+	{
+		g_statistics.busyFlagReads++;
+		return ((HOST_CLOCK_nowNs() < g_busyUntilNs) ? 0x80 : 0x00) | (g_addressCounter & 0x7F);
+	}
+	g_statistics.dataReads++;
+	value = g_inCgram ? g_cgram[g_addressCounter] : g_ddram[MODEL_ddramIndex(g_addressCounter)];
+	MODEL_moveAddressCounter(g_increment);
+	return value;
+}
+
+/* drive the data pins with the read byte, or the nibble of this transfer */
+static void MODEL_driveData(void)
+{
+	uint8 value = g_readValue;
+
+	if (g_config.dataBits == 8)
+	{
+		HOST_GPIO_drive(g_config.dataPort, 0xFF, value);
+		return;
+	}
+	if (!g_eightBits && g_lowNibbleNext)
+	{
+		value <<= 4;
+	}
+	HOST_GPIO_drive(g_config.dataPort, MODEL_dataPinsMask(), (uint8)((value >> 4) << g_config.firstDataPin));
+}
+
+static void MODEL_enableRise(uint64 now)
+{
+	if ((now - g_controlChangeNs) < HD44780_MODEL_T_AS_NS)
+		MODEL_violation(HD44780_MODEL_ADDRESS_SETUP);
+	if ((g_eRiseNs != MODEL_NO_TIME) && ((now - g_eRiseNs) < HD44780_MODEL_T_CYCE_NS))
+		MODEL_violation(HD44780_MODEL_ENABLE_CYCLE_TIME);
+	g_eRiseNs = now;
+	g_contentionReported = FALSE;
+
+	if (g_rw)
+	{
+		if (g_eightBits || !g_lowNibbleNext)
+		{
+			g_readValue = MODEL_readValue();
+		}
+		MODEL_driveData();
+	}
+}
+
+static void MODEL_enableFall(uint64 now)
+{
+	uint8 value;
+
+	if ((now - g_eRiseNs) < HD44780_MODEL_PW_EH_NS)
+		MODEL_violation(HD44780_MODEL_ENABLE_PULSE_WIDTH);
+	g_eFallNs = now;
+
+	if (g_rw)
+	{
+		HOST_GPIO_drive(g_config.dataPort, 0, 0);
+		if (!g_eightBits)
+			g_lowNibbleNext = !g_lowNibbleNext;
+		return;
+	}
+	if ((now - g_dataChangeNs) < HD44780_MODEL_T_DSW_NS)
+		MODEL_violation(HD44780_MODEL_DATA_SETUP);
+
+	value = MODEL_dataLevel();
+	if (g_eightBits)
+	{
+		MODEL_write(value);
+	}
+	else if (!g_lowNibbleNext)
+	{
+		g_highNibble = value & 0xF0;
+		g_lowNibbleNext = TRUE;
+	}
+	else
+	{
+		g_lowNibbleNext = FALSE;
+		MODEL_write(g_highNibble | (value >> 4));
+	}
+}
+
+/* host GPIO callback: sample the pins after every change and check the timing */
+static void MODEL_pinsAccessed(HOST_GPIO_AccessType access)
+{
+	uint64 now = HOST_CLOCK_nowNs();
+	uint8 rs, rw, e, data;
+
+	if (access == HOST_GPIO_PINS_READ)
+	{
+		if (g_e && g_rw && ((now - g_eRiseNs) < HD44780_MODEL_T_DDR_NS))
+			MODEL_violation(HD44780_MODEL_READ_BEFORE_VALID);
+		return;
+	}
+
+	rs = MODEL_pinLevel(g_config.rsPort, g_config.rsPin);
+	rw = MODEL_pinLevel(g_config.rwPort, g_config.rwPin);
+	e = MODEL_pinLevel(g_config.ePort, g_config.ePin);
+
+	if ((rs != g_rs) || (rw != g_rw))
+	{
+		if (g_e || ((now - g_eFallNs) < HD44780_MODEL_T_AH_NS))
+			MODEL_violation(HD44780_MODEL_ADDRESS_HOLD);
+		g_rs = rs;
+		g_rw = rw;
+		g_controlChangeNs = now;
+	}
+
+	data = MODEL_dataLevel();
+	if (data != g_data)
+	{
+		if (!g_rw && !g_e && ((now - g_eFallNs) < HD44780_MODEL_T_H_NS))
+			MODEL_violation(HD44780_MODEL_DATA_HOLD);
+		g_data = data;
+		g_dataChangeNs = now;
+	}
+
+	if (e != g_e)
+	{
+		g_e = e;
+		if (e)
+			MODEL_enableRise(now);
+		else
+			MODEL_enableFall(now);
+	}
+
+	/* the MCU drives the data pins while the LCD outputs the read byte */
+	if (g_rw && g_e && !g_contentionReported && (HOST_GPIO_getPortDirection(g_config.dataPort) & MODEL_dataPinsMask()))
+	{
+		MODEL_violation(HD44780_MODEL_BUS_CONTENTION);
+		g_contentionReported = TRUE;
+	}
+}
+
+void HD44780_MODEL_init(const HD44780_MODEL_ConfigType *Config_Ptr)
+{
+	g_config = *Config_Ptr;
+	if (g_config.rows > HD44780_MODEL_MAX_ROWS)
+		g_config.rows = HD44780_MODEL_MAX_ROWS;
+	if (g_config.cols > HD44780_MODEL_MAX_COLS)
+		g_config.cols = HD44780_MODEL_MAX_COLS;
+	memset(&g_statistics, 0, sizeof(g_statistics));
+
+	/* internal reset state: 8-bit interface, one line, display off, increment */
+	memset(g_ddram, ' ', sizeof(g_ddram));
+	memset(g_cgram, 0, sizeof(g_cgram));
+	g_addressCounter = 0;
+	g_inCgram = FALSE;
+	g_increment = TRUE;
+	g_shiftOnWrite = FALSE;
+	g_displayOn = FALSE;
+	g_eightBits = TRUE;
+	g_twoLines = FALSE;
+	g_displayShift = 0;
+	g_powerOnNs = HOST_CLOCK_nowNs();
+	g_busyUntilNs = g_powerOnNs + HD44780_MODEL_POWER_ON_NS;
+
+	g_lowNibbleNext = FALSE;
+	g_contentionReported = FALSE;
+	g_controlChangeNs = g_dataChangeNs = g_eFallNs = 0;
+	g_eRiseNs = MODEL_NO_TIME;
+
+	HOST_GPIO_setCallBack(MODEL_pinsAccessed);
+	g_rs = MODEL_pinLevel(g_config.rsPort, g_config.rsPin);
+	g_rw = MODEL_pinLevel(g_config.rwPort, g_config.rwPin);
+	g_e = MODEL_pinLevel(g_config.ePort, g_config.ePin);
+	g_data = MODEL_dataLevel();
+	MODEL_recordFrame();
+}
+
+void HD44780_MODEL_setViolationCallBack(void(*a_ptr)(HD44780_MODEL_ViolationType violation, uint64 timeNs))
+{
+	g_violationCallBackPtr = a_ptr;
+}
+
+const char *HD44780_MODEL_violationName(HD44780_MODEL_ViolationType violation)
+{
+	return (violation < HD44780_MODEL_NUM_OF_VIOLATIONS) ? g_violationNames[violation] : "unknown";
+}
+
+void HD44780_MODEL_getStatistics(HD44780_MODEL_StatisticsType *statistics)
+{
+	*statistics = g_statistics;
+}
+
+uint32 HD44780_MODEL_getViolationCount(void)
+{
+	uint32 count = 0;
+	uint8 i;
+
+	for (i = 0; i < HD44780_MODEL_NUM_OF_VIOLATIONS; i++)
+	{
+		count += g_statistics.violations[i];
+	}
+	return count;
+}
+
+void HD44780_MODEL_getScreen(HD44780_MODEL_FrameType *frame)
+{
+	uint8 row, col;
+
+	memset(frame, 0, sizeof(*frame));
+	frame->timeNs = HOST_CLOCK_nowNs();
+	for (row = 0; row < g_config.rows; row++)
+	{
+		for (col = 0; col < g_config.cols; col++)
+		{
+			frame->cells[row][col] = g_displayOn ? g_ddram[MODEL_ddramIndex(MODEL_cellAddress(row, col))] : ' ';
+		}
+	}
+}
+
+boolean HD44780_MODEL_getFrame(uint32 index, HD44780_MODEL_FrameType *frame)
+{
+	if ((index >= g_statistics.frames) || (g_statistics.frames - index > HD44780_MODEL_MAX_FRAMES))
+	{
+		return FALSE;
+	}
+	*frame = g_frames[index % HD44780_MODEL_MAX_FRAMES];
+	return TRUE;
+}
+
+void HD44780_MODEL_rowToText(const HD44780_MODEL_FrameType *frame, uint8 row, char *text)
+{
+	uint8 col, code;
+
+	for (col = 0; col < g_config.cols; col++)
+	{
+		code = frame->cells[row][col];
+		if (code < 0x10)
+			text[col] = '0' + (code & 0x07);
+		else if (code == 0xFF)
+			text[col] = '#';
+		else if ((code < 0x20) || (code > 0x7E))
+			text[col] = '?';
+		else
+			text[col] = (char)code;
+	}
+	text[col] = '\0';
+}
+
+const uint8 *HD44780_MODEL_getGlyph(uint8 code)
+{
+	return &g_cgram[(code & 0x07) * HD44780_MODEL_GLYPH_HEIGHT];
+}
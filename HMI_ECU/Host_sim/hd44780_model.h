@@ -0,0 +1,165 @@
+/******************************************************************************
+ *
+ * Module: HD44780 model
+ *
+ * File Name: hd44780_model.h
+ *
+ * Description: Header file for the host model of the HD44780 character LCD controller,
+ * 				it decodes the RS/RW/E/data pins of the host GPIO backend, keeps the
+ * 				DDRAM and the CGRAM, checks the bus timing and records the screen frames
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef HD44780_MODEL_H_
+#define HD44780_MODEL_H_
+
+#include "std_types.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+#define HD44780_MODEL_DDRAM_SIZE			80
+#define HD44780_MODEL_CGRAM_SIZE			64
+#define HD44780_MODEL_GLYPH_HEIGHT			8
+#define HD44780_MODEL_MAX_ROWS				4
+#define HD44780_MODEL_MAX_COLS				20
+
+/* frames kept for inspection, the older ones are overwritten */
+#define HD44780_MODEL_MAX_FRAMES			1024
+
+/* datasheet bus timing (VCC = 4.5 V to 5.5 V), in nanoseconds */
+#define HD44780_MODEL_T_AS_NS				40		/* RS/RW setup to E rise */
+#define HD44780_MODEL_T_AH_NS				10		/* RS/RW hold after E fall */
+#define HD44780_MODEL_PW_EH_NS				230		/* E high pulse width */
+#define HD44780_MODEL_T_CYCE_NS				500		/* E cycle time */
+#define HD44780_MODEL_T_DSW_NS				80		/* data setup to E fall (write) */
+#define HD44780_MODEL_T_H_NS				10		/* data hold after E fall (write) */
+#define HD44780_MODEL_T_DDR_NS				160		/* data valid after E rise (read) */
+
+/* execution times at fosc = 270 kHz and the internal reset after the power on */
+#define HD44780_MODEL_EXEC_NS				37000UL
+#define HD44780_MODEL_CLEAR_EXEC_NS			1520000UL
+#define HD44780_MODEL_POWER_ON_NS			15000000UL
+
+/*-------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum
+{
+	HD44780_MODEL_ADDRESS_SETUP,HD44780_MODEL_ADDRESS_HOLD,HD44780_MODEL_ENABLE_PULSE_WIDTH,
+	HD44780_MODEL_ENABLE_CYCLE_TIME,HD44780_MODEL_DATA_SETUP,HD44780_MODEL_DATA_HOLD,
+	HD44780_MODEL_READ_BEFORE_VALID,HD44780_MODEL_WRITE_WHILE_BUSY,HD44780_MODEL_BUS_CONTENTION,
+	HD44780_MODEL_POWER_ON_RESET,HD44780_MODEL_NUM_OF_VIOLATIONS
+}HD44780_MODEL_ViolationType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: HD44780_MODEL_ConfigType
+ *
+ * [Description]: Wiring of the LCD pins (GPIO port and pin ids) and the display size
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+			uint8	rsPort;
+			uint8	rsPin;
+			uint8	rwPort;
+			uint8	rwPin;
+			uint8	ePort;
+			uint8	ePin;
+	/*
+	 * dataPort/firstDataPin/dataBits: D0-D7 on the whole port (8), or D4-D7 on the
+	 * 4 pins from firstDataPin (4)
+	 */
+			uint8	dataPort;
+			uint8	firstDataPin;
+			uint8	dataBits;
+			uint8	rows;
+			uint8	cols;
+}HD44780_MODEL_ConfigType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: HD44780_MODEL_FrameType
+ *
+ * [Description]: What the display showed from timeNs on: the character codes of the
+ * 				  visible cells (blank while the display is off)
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+			uint64	timeNs;
+			uint8	cells[HD44780_MODEL_MAX_ROWS][HD44780_MODEL_MAX_COLS];
+}HD44780_MODEL_FrameType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: HD44780_MODEL_StatisticsType
+ *
+ * [Description]: Counters since the model was powered on
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+			uint32	instructions;
+			uint32	dataWrites;
+			uint32	busyFlagReads;
+			uint32	dataReads;
+			uint32	ignoredWrites;
+			uint32	frames;
+			uint32	violations[HD44780_MODEL_NUM_OF_VIOLATIONS];
+}HD44780_MODEL_StatisticsType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*
+ * Description :
+ * Power the model on now (8-bit interface, one line, display off, DDRAM blank) and
+ * connect it to the host GPIO backend.
+ */
+void HD44780_MODEL_init(const HD44780_MODEL_ConfigType *Config_Ptr);
+
+/*
+ * Description :
+ * Set the function called for every timing violation.
+ */
+void HD44780_MODEL_setViolationCallBack(void(*a_ptr)(HD44780_MODEL_ViolationType violation, uint64 timeNs));
+
+/*
+ * Description :
+ * Return a short description of a violation.
+ */
+const char *HD44780_MODEL_violationName(HD44780_MODEL_ViolationType violation);
+
+void HD44780_MODEL_getStatistics(HD44780_MODEL_StatisticsType *statistics);
+
+/*
+ * Description :
+ * Return the sum of all the violation counters.
+ */
+uint32 HD44780_MODEL_getViolationCount(void);
+
+/*
+ * Description :
+ * Fill frame with what the display shows now.
+ */
+void HD44780_MODEL_getScreen(HD44780_MODEL_FrameType *frame);
+
+/*
+ * Description :
+ * Get a recorded frame, index counts from 0 at the power on. Return FALSE if the frame
+ * is not recorded yet or already overwritten.
+ */
+boolean HD44780_MODEL_getFrame(uint32 index, HD44780_MODEL_FrameType *frame);
+
+/*
+ * Description :
+ * Write a row of a frame as text in a buffer of cols + 1 chars: the CGRAM codes (0-15)
+ * are shown as '0'-'7' and the solid block (0xFF) as '#'.
+ */
+void HD44780_MODEL_rowToText(const HD44780_MODEL_FrameType *frame, uint8 row, char *text);
+
+/*
+ * Description :
+ * Return the 8 pixel rows of a CGRAM glyph (character code 0-15).
+ */
+const uint8 *HD44780_MODEL_getGlyph(uint8 code);
+
+#endif /* HD44780_MODEL_H_ */
@@ -0,0 +1,25 @@
+/******************************************************************************
+ *
+ * Module: Host clock
+ *
+ * File Name: host_clock.c
+ *
+ * Description: Source file for the simulated time base of the host simulation builds
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "host_clock.h"
+
+static uint64 g_nowNs = 0;
+
+uint64 HOST_CLOCK_nowNs(void)
+{
+	return g_nowNs;
+}
+
+void HOST_CLOCK_advanceNs(uint64 ns)
+{
+	g_nowNs += ns;
+}
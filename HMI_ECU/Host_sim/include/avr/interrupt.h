@@ -0,0 +1,24 @@
+/******************************************************************************
+ *
+ * Module: Host simulation shims
+ *
+ * File Name: interrupt.h
+ *
+ * Description: Stand-in for <avr/interrupt.h> in the host simulation builds,
+ * 				the simulation is single threaded so the global interrupt enable
+ * 				is only the I bit of the SREG variable
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define sei()				(SREG |= 0x80)
+#define cli()				(SREG &= 0x7F)
+#define ISR(vector)			void vector(void)
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
@@ -0,0 +1,31 @@
+/******************************************************************************
+ *
+ * Module: Host simulation shims
+ *
+ * File Name: io.h
+ *
+ * Description: Stand-in for <avr/io.h> in the host simulation builds. The I/O port
+ * 				registers are plain variables, the host GPIO backend (gpio_host.c)
+ * 				connects them to the device models.
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+extern volatile unsigned char PORTA, DDRA, PINA;
+extern volatile unsigned char PORTB, DDRB, PINB;
+extern volatile unsigned char PORTC, DDRC, PINC;
+extern volatile unsigned char PORTD, DDRD, PIND;
+
+extern volatile unsigned char SREG;
+
+/* the static pin API of gpio.h accesses the registers directly, these tell the backend */
+void HOST_GPIO_staticWritten(void);
+void HOST_GPIO_staticRead(unsigned char port_num);
+#define GPIO_STATIC_WRITE_HOOK()			HOST_GPIO_staticWritten()
+#define GPIO_STATIC_READ_HOOK(port_num)		HOST_GPIO_staticRead(port_num)
+
+#endif /* HOST_AVR_IO_H_ */
@@ -0,0 +1,22 @@
+/******************************************************************************
+ *
+ * Module: Host simulation shims
+ *
+ * File Name: delay.h
+ *
+ * Description: Stand-in for <util/delay.h> in the host simulation builds,
+ * 				the delays advance the simulated clock instead of busy waiting
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#include "host_clock.h"
+
+#define _delay_us(us)		HOST_CLOCK_advanceNs((uint64)(us) * 1000)
+#define _delay_ms(ms)		HOST_CLOCK_advanceNs((uint64)(ms) * 1000000)
+
+#endif /* HOST_UTIL_DELAY_H_ */
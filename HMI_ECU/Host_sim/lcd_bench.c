@@ -0,0 +1,251 @@
+/******************************************************************************
+ *
+ * Module: Host simulation
+ *
+ * File Name: lcd_bench.c
+ *
+ * Description: Native Linux test of the HMI ECU LCD driver on the HD44780 model:
+ * 				screen contents, update time of every screen and bus timing
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "lcd.h"
+#include "gpio_host.h"
+#include "hd44780_model.h"
+#include "host_clock.h"
+
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+/* the LCD task runs from the 1 ms timer tick */
+#define BENCH_TICK_NS				1000000ULL
+/* longest ATmega16 start-up time (crystal, 16K CK + 64 ms), then the HMI calls LCD_init */
+#define BENCH_STARTUP_NS			65000000ULL
+#define BENCH_TASK_LIMIT			10000
+#define BENCH_BAR_WIDTH				16
+#define BENCH_BAR_STEPS				(BENCH_BAR_WIDTH * LCD_GLYPH_WIDTH)
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+static uint32 g_failures = 0;
+static boolean g_printViolations = TRUE;
+
+/*------------------------------------------------------------------------------
+ *                       Functions Definitions                                  *
+--------------------------------------------------------------------------------*/
+static void BENCH_violation(HD44780_MODEL_ViolationType violation, uint64 timeNs)
+{
+	if (g_printViolations)
+	{
+		printf("  timing violation at %.3f ms: %s\n", timeNs / 1e6, HD44780_MODEL_violationName(violation));
+	}
+}
+
+/* run the LCD task every tick until everything is on the LCD, return the number of ticks */
+static uint32 BENCH_runTasks(void)
+{
+	uint32 ticks = 0;
+
+	while (!LCD_isIdle() && (ticks < BENCH_TASK_LIMIT))
+	{
+		LCD_task();
+		ticks++;
+		HOST_CLOCK_advanceNs(BENCH_TICK_NS - (HOST_CLOCK_nowNs() % BENCH_TICK_NS));
+	}
+	return ticks;
+}
+
+static void BENCH_expectRow(uint8 row, const char *expected)
+{
+	HD44780_MODEL_FrameType frame;
+	char text[HD44780_MODEL_MAX_COLS + 1];
+
+	HD44780_MODEL_getScreen(&frame);
+	HD44780_MODEL_rowToText(&frame, row, text);
+	if (strncmp(text, expected, strlen(expected)) != 0)
+	{
+		printf("  FAIL row %u: \"%s\", expected \"%s\"\n", row, text, expected);
+		g_failures++;
+	}
+}
+
+/*
+ * Print the screen and how long the update took: from the start of the drawing to the
+ * last frame it produced (to now if the screen did not change), the number of LCD
+ * transfers and of task ticks
+ */
+static void BENCH_report(const char *name, uint64 startNs, uint32 firstFrame, uint32 ticks,
+						 const HD44780_MODEL_StatisticsType *before)
+{
+	HD44780_MODEL_StatisticsType after;
+	HD44780_MODEL_FrameType frame;
+	char text[HD44780_MODEL_MAX_COLS + 1];
+	uint64 lastFrameNs = HOST_CLOCK_nowNs();
+	uint8 row;
+
+	HD44780_MODEL_getStatistics(&after);
+	if ((after.frames > firstFrame) && HD44780_MODEL_getFrame(after.frames - 1, &frame))
+	{
+		lastFrameNs = frame.timeNs;
+	}
+	printf("%-24s %9.3f ms %4u transfers %4u ticks %3u frames\n", name, (lastFrameNs - startNs) / 1e6,
+		   (after.instructions + after.dataWrites) - (before->instructions + before->dataWrites),
+		   ticks, after.frames - firstFrame);
+	HD44780_MODEL_getScreen(&frame);
+	for (row = 0; row < LCD_NUM_ROWS; row++)
+	{
+		HD44780_MODEL_rowToText(&frame, row, text);
+		printf("    |%s|\n", text);
+	}
+}
+
+/* a screen update: drawing functions then the LCD task until idle */
+#define BENCH_UPDATE(name, drawing) \
+	do \
+	{ \
+		HD44780_MODEL_StatisticsType before; \
+		uint64 startNs = HOST_CLOCK_nowNs(); \
+		uint32 ticks; \
+		HD44780_MODEL_getStatistics(&before); \
+		drawing; \
+		ticks = BENCH_runTasks(); \
+		BENCH_report(name, startNs, before.frames, ticks, &before); \
+	} while (0)
+
+/* the bar cells must show value steps: full blocks, one partial glyph, then blanks */
+static void BENCH_expectBar(uint8 row, uint8 col, uint8 value)
+{
+	HD44780_MODEL_FrameType frame;
+	const uint8 *glyph;
+	uint8 cell, code, expected, columns;
+
+	HD44780_MODEL_getScreen(&frame);
+	for (cell = 0; cell < BENCH_BAR_WIDTH; cell++)
+	{
+		code = frame.cells[row][col + cell];
+		expected = (value >= (cell + 1) * LCD_GLYPH_WIDTH) ? LCD_GLYPH_WIDTH :
+				   (value > cell * LCD_GLYPH_WIDTH) ? value - cell * LCD_GLYPH_WIDTH : 0;
+		if (code == 0xFF)
+			columns = LCD_GLYPH_WIDTH;
+		else if (code == ' ')
+			columns = 0;
+		else if (code < 0x10)
+		{
+			/* pixel columns lit from the left in the first row of the glyph */
+			glyph = HD44780_MODEL_getGlyph(code);
+			for (columns = 0; (columns < LCD_GLYPH_WIDTH) && (glyph[0] & (0x10 >> columns)); columns++);
+		}
+		else
+			columns = 0xFF;
+		if (columns != expected)
+		{
+			printf("  FAIL bar value %u cell %u: %u columns, expected %u\n", value, cell, columns, expected);
+			g_failures++;
+			return;
+		}
+	}
+}
+
+/* a data write right after the previous one, without waiting for the busy flag */
+static void BENCH_writeWithoutWait(uint8 data)
+{
+	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_HIGH);
+#if (LCD_DATA_BITS_MODE == 4)
+	GPIO_writePort(LCD_DATA_PORT_ID, (data >> 4) << LCD_FIRST_DATA_PIN_ID);
+	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_writePort(LCD_DATA_PORT_ID, (data & 0x0F) << LCD_FIRST_DATA_PIN_ID);
+#else
+	GPIO_writePort(LCD_DATA_PORT_ID, data);
+#endif
+	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_LOW);
+}
+
+int main(void)
+{
+	HD44780_MODEL_ConfigType config = {LCD_RS_PORT_ID, LCD_RS_PIN_ID, LCD_RW_PORT_ID, LCD_RW_PIN_ID,
+									   LCD_E_PORT_ID, LCD_E_PIN_ID, LCD_DATA_PORT_ID,
+#if (LCD_DATA_BITS_MODE == 4)
+									   LCD_FIRST_DATA_PIN_ID, 4,
+#else
+									   0, 8,
+#endif
+									   LCD_NUM_ROWS, LCD_NUM_COLS};
+	HD44780_MODEL_StatisticsType statistics;
+	LCD_ProgressBarType bar;
+	uint32 violations;
+	uint16 value;
+	uint8 i;
+
+	HOST_GPIO_init();
+	HD44780_MODEL_init(&config);
+	HD44780_MODEL_setViolationCallBack(BENCH_violation);
+	HOST_CLOCK_advanceNs(BENCH_STARTUP_NS);
+
+	BENCH_UPDATE("init", LCD_init());
+	BENCH_expectRow(0, "                    ");
+
+	BENCH_UPDATE("enter password", LCD_displayStringRowColumn(0, 0, "Plz enter pass:"); LCD_moveCursor(1, 0));
+	BENCH_expectRow(0, "Plz enter pass:     ");
+
+	for (i = 0; i < 5; i++)
+	{
+		BENCH_UPDATE("key echo", LCD_displayCharacter('*'));
+	}
+	BENCH_expectRow(1, "*****");
+
+	BENCH_UPDATE("main options", LCD_clearScreen(); LCD_displayStringRowColumn(0, 0, "+ : Open Door");
+				 LCD_displayStringRowColumn(1, 0, "- : Change Pass"));
+	BENCH_expectRow(0, "+ : Open Door       ");
+	BENCH_expectRow(1, "- : Change Pass     ");
+
+	BENCH_UPDATE("door screen", LCD_clearScreen(); LCD_displayStringRowColumn(0, 0, "Door is Unlocking");
+				 LCD_progressBarInit(&bar, 1, 0, BENCH_BAR_WIDTH));
+	for (value = 1; value <= BENCH_BAR_STEPS; value++)
+	{
+		LCD_progressBarSet(&bar, value, BENCH_BAR_STEPS);
+		BENCH_runTasks();
+		BENCH_expectBar(1, 0, (uint8)value);
+	}
+	BENCH_UPDATE("progress bar step", LCD_progressBarSet(&bar, BENCH_BAR_STEPS / 2 + 1, BENCH_BAR_STEPS));
+	BENCH_expectBar(1, 0, BENCH_BAR_STEPS / 2 + 1);
+	LCD_progressBarRelease(&bar);
+
+	BENCH_UPDATE("danger countdown", LCD_clearScreen(); LCD_displayStringRowColumn(0, 0, "DANGER !");
+				 LCD_displayStringRowColumn(1, 0, "ALERT ON!"); LCD_displayCountdownRowColumn(1, 15, 60));
+	BENCH_UPDATE("countdown second", LCD_displayCountdownRowColumn(1, 15, 59));
+	BENCH_expectRow(1, "ALERT ON!      00:59");
+
+	BENCH_UPDATE("flush barrier", LCD_displayStringRowColumn(0, 0, "Flushed"); LCD_flush());
+	BENCH_expectRow(0, "Flushed!");
+
+	violations = HD44780_MODEL_getViolationCount();
+	HD44780_MODEL_getStatistics(&statistics);
+	printf("LCD driver: %u instructions, %u data writes, %u busy flag reads, %u timing violations\n",
+		   statistics.instructions, statistics.dataWrites, statistics.busyFlagReads, violations);
+	if (violations != 0)
+	{
+		g_failures++;
+	}
+
+	/* the timing check itself: two writes 37 us apart at most, the second one is ignored */
+	g_printViolations = FALSE;
+	BENCH_writeWithoutWait('X');
+	BENCH_writeWithoutWait('Y');
+	HD44780_MODEL_getStatistics(&statistics);
+	if ((statistics.violations[HD44780_MODEL_WRITE_WHILE_BUSY] == 0) || (statistics.ignoredWrites == 0))
+	{
+		printf("  FAIL the model did not report a write while busy\n");
+		g_failures++;
+	}
+
+	printf("%u failures\n", g_failures);
+	return (g_failures == 0) ? 0 : 1;
+}
@@ -1,149 +1,303 @@
- /******************************************************************************
- *
- * Module: KEYPAD
- *
- * File Name: keypad.c
- *
- * Description: Source file for the Keypad driver
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-#include "common_macros.h" /* To use the macros like SET_BIT */
-#include "keypad.h"
-#include "gpio.h"
-
-/*******************************************************************************
- *                      Functions Prototypes(Private)                          *
- *******************************************************************************/
-
-#if (KEYPAD_NUM_COLS == 3)
-/*
- * Function responsible for mapping the switch number in the keypad to
- * its corresponding functional number in the proteus for 4x3 keypad
- */
-static uint8 KEYPAD_4x3_adjustKeyNumber(uint8 button_number);
-#elif (KEYPAD_NUM_COLS == 4)
-/*
- * Function responsible for mapping the switch number in the keypad to
- * its corresponding functional number in the proteus for 4x4 keypad
- */
-static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
-#endif
-
-/*******************************************************************************
- *                      Functions Definitions                                  *
- *******************************************************************************/
-uint8 KEYPAD_getPressedKey(void)
-{
-	uint8 col,row;
-	uint8 keypad_port_value = 0;
-	while(1)
-	{
-		for(col=0;col<KEYPAD_NUM_COLS;col++) /* loop for columns */
-		{
-			/* 
-			 * Each time setup the direction for all keypad port as input pins,
-			 * except this column will be output pin
-			 */
-			GPIO_setupPortDirection(KEYPAD_PORT_ID,PORT_INPUT);
-			GPIO_setupPinDirection(KEYPAD_PORT_ID,KEYPAD_FIRST_COLUMN_PIN_ID+col,PIN_OUTPUT);
-			
-#if(KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
-			/* Clear the column output pin and set the rest pins value */
-			keypad_port_value = ~(1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col));
-#else
-			/* Set the column output pin and clear the rest pins value */
-			keypad_port_value = (1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col));
-#endif
-			GPIO_writePort(KEYPAD_PORT_ID,keypad_port_value);
-
-			for(row=0;row<KEYPAD_NUM_ROWS;row++) /* loop for rows */
-			{
-				/* Check if the switch is pressed in this row */
-				if(GPIO_readPin(KEYPAD_PORT_ID,row+KEYPAD_FIRST_ROW_PIN_ID) == KEYPAD_BUTTON_PRESSED)
-				{
-					#if (KEYPAD_NUM_COLS == 3)
-						return KEYPAD_4x3_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
-					#elif (KEYPAD_NUM_COLS == 4)
-						return KEYPAD_4x4_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
-					#endif
-				}
-			}
-		}
-	}	
-}
-
-#if (KEYPAD_NUM_COLS == 3)
-
-/*
- * Description :
- * Update the keypad pressed button value with the correct one in keypad 4x3 shape
- */
-static uint8 KEYPAD_4x3_adjustKeyNumber(uint8 button_number)
-{
-	uint8 keypad_button = 0;
-	switch(button_number)
-	{
-		case 10: keypad_button = '*'; // ASCII Code of *
-				 break;
-		case 11: keypad_button = 0;
-				 break;		
-		case 12: keypad_button = '#'; // ASCII Code of #
-				 break;
-		default: keypad_button = button_number;
-				break;
-	}
-	return keypad_button;
-} 
-
-#elif (KEYPAD_NUM_COLS == 4)
-
-/*
- * Description :
- * Update the keypad pressed button value with the correct one in keypad 4x4 shape
- */
-static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number)
-{
-	uint8 keypad_button = 0;
-	switch(button_number)
-	{
-		case 1: keypad_button = 7;
-				break;
-		case 2: keypad_button = 8;
-				break;
-		case 3: keypad_button = 9;
-				break;
-		case 4: keypad_button = '%'; // ASCII Code of %
-				break;
-		case 5: keypad_button = 4;
-				break;
-		case 6: keypad_button = 5;
-				break;
-		case 7: keypad_button = 6;
-				break;
-		case 8: keypad_button = '*'; /* ASCII Code of '*' */
-				break;		
-		case 9: keypad_button = 1;
-				break;
-		case 10: keypad_button = 2;
-				break;
-		case 11: keypad_button = 3;
-				break;
-		case 12: keypad_button = '-'; /* ASCII Code of '-' */
-				break;
-		case 13: keypad_button = 13;  /* ASCII of Enter */
-				break;			
-		case 14: keypad_button = 0;
-				break;
-		case 15: keypad_button = '='; /* ASCII Code of '=' */
-				break;
-		case 16: keypad_button = '+'; /* ASCII Code of '+' */
-				break;
-		default: keypad_button = button_number;
-				break;
-	}
-	return keypad_button;
-} 
-
-#endif
+ /******************************************************************************
+ *
+ * Module: KEYPAD
+ *
+ * File Name: keypad.c
+ *
+ * Description: Source file for the Keypad driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include "keypad.h"
+#include "gpio.h" /* The static pin API: the keypad port is fixed */
+#include <avr/io.h> /* For SREG */
+#include <avr/pgmspace.h> /* To keep the scan and key tables in flash */
+#include <avr/interrupt.h> /* For cli() while reading the scan time */
+#include <util/delay.h> /* For the settle time of the rows */
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for reading the whole matrix: bit ((row*KEYPAD_NUM_COLS)+col)
+ * is set if that switch is pressed
+ */
+static uint16 KEYPAD_scanMatrix(void);
+
+/*
+ * Function responsible for finding the keys that can not be trusted in this scan
+ * because they are part of a pressed rectangle (possible ghost key)
+ */
+static uint16 KEYPAD_ghostMask(uint16 keys);
+
+/*
+ * Function responsible for queuing one event for every set bit of the edges bitmap
+ */
+static void KEYPAD_pushEdges(uint16 edges, KEYPAD_EdgeType edge);
+
+/*
+ * Function responsible for adding a key event to the queue
+ */
+static void KEYPAD_pushEvent(uint8 key, KEYPAD_EdgeType edge);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+/*
+ * Spread the row nibble of one column to the bitmap positions of its keys:
+ * row bit r goes to bit (r*KEYPAD_NUM_COLS), the column is added by a shift.
+ */
+#define KEYPAD_SPREAD(n)	((uint16)((((n)>>0)&1) | ((((n)>>1)&1)<<KEYPAD_NUM_COLS) | \
+							(((uint16)(((n)>>2)&1))<<(2*KEYPAD_NUM_COLS)) | (((uint16)(((n)>>3)&1))<<(3*KEYPAD_NUM_COLS))))
+
+static const uint16 g_rowSpread[16] PROGMEM =
+{
+	KEYPAD_SPREAD(0), KEYPAD_SPREAD(1), KEYPAD_SPREAD(2), KEYPAD_SPREAD(3),
+	KEYPAD_SPREAD(4), KEYPAD_SPREAD(5), KEYPAD_SPREAD(6), KEYPAD_SPREAD(7),
+	KEYPAD_SPREAD(8), KEYPAD_SPREAD(9), KEYPAD_SPREAD(10),KEYPAD_SPREAD(11),
+	KEYPAD_SPREAD(12),KEYPAD_SPREAD(13),KEYPAD_SPREAD(14),KEYPAD_SPREAD(15)
+};
+
+/* Key value of every switch (bitmap position), as printed on the proteus keypad */
+#if (KEYPAD_NUM_COLS == 3)
+static const uint8 g_keyMap[KEYPAD_NUM_OF_KEYS] PROGMEM =
+{
+	1,   2, 3,
+	4,   5, 6,
+	7,   8, 9,
+	'*', 0, '#'
+};
+#elif (KEYPAD_NUM_COLS == 4)
+static const uint8 g_keyMap[KEYPAD_NUM_OF_KEYS] PROGMEM =
+{
+	7,  8, 9,   '%',
+	4,  5, 6,   '*',
+	1,  2, 3,   '-',
+	13, 0, '=', '+'  /* 13 is the ASCII of Enter */
+};
+#endif
+
+/*
+ * Single producer (scan task in the timer ISR) / single consumer (main loop) queue.
+ * The producer only writes the head and the consumer only writes the tail, both are
+ * one byte so their updates are atomic and no interrupt locking is needed.
+ */
+static volatile KEYPAD_EventType g_eventQueue[KEYPAD_EVENT_QUEUE_SIZE];
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+/* time of the current scan in ms, advanced by the scan task and used to stamp the events */
+static volatile uint16 g_scanTime = 0;
+
+/*
+ * Debounce state of all the keys at once: the accepted (stable) pressed keys, and a
+ * 2-bit counter per key split in two bitmaps (vertical counter) that counts how many
+ * scans in a row the key has read different from its stable state.
+ */
+static uint16 g_stableKeys = 0;
+static uint16 g_settleCount0 = 0;
+static uint16 g_settleCount1 = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description :
+ * Drive one column at a time and read the rows of that column with a single
+ * access to the PIN register, the row nibble is moved to the bitmap by g_rowSpread.
+ */
+static uint16 KEYPAD_scanMatrix(void)
+{
+	uint8 col;
+	uint8 rows;
+	uint16 keys = 0;
+
+	for(col=0;col<KEYPAD_NUM_COLS;col++) /* loop for columns */
+	{
+		/* All keypad pins are inputs except this column */
+		GPIO_STATIC_SETUP_PORT_DIRECTION(KEYPAD_PORT_ID,(1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col)));
+#if(KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
+		/* Clear the column output pin and pull up the rest pins */
+		GPIO_STATIC_WRITE_PORT(KEYPAD_PORT_ID,~(1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col)));
+#else
+		/* Set the column output pin and clear the rest pins value */
+		GPIO_STATIC_WRITE_PORT(KEYPAD_PORT_ID,(1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col)));
+#endif
+		/*
+		 * a row pulled low by the previous column rises back through the internal pull-up
+		 * (about 1 us with the matrix capacitance), it must settle before the rows are read
+		 */
+		_delay_us(KEYPAD_SETTLE_TIME_US);
+
+		rows = GPIO_STATIC_READ_PORT(KEYPAD_PORT_ID) >> KEYPAD_FIRST_ROW_PIN_ID;
+#if(KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
+		rows = ~rows;
+#endif
+		keys |= pgm_read_word(&g_rowSpread[rows & 0x0F]) << col;
+	}
+	return keys;
+}
+
+/*
+ * Description :
+ * Without diodes, when three corners of a rectangle in the matrix are pressed the
+ * fourth one reads pressed too. A rectangle exists when two rows have two or more
+ * pressed columns in common, and then none of its keys can be trusted.
+ */
+static uint16 KEYPAD_ghostMask(uint16 keys)
+{
+	uint8 row_a,row_b;
+	uint16 common;
+	uint16 mask = 0;
+	const uint16 row_mask = (1u << KEYPAD_NUM_COLS) - 1;
+
+	for(row_a=0;row_a<KEYPAD_NUM_ROWS-1;row_a++)
+	{
+		for(row_b=row_a+1;row_b<KEYPAD_NUM_ROWS;row_b++)
+		{
+			common = (keys >> (row_a*KEYPAD_NUM_COLS)) & (keys >> (row_b*KEYPAD_NUM_COLS)) & row_mask;
+			/* more than one bit set */
+			if(common & (common - 1))
+			{
+				mask |= (common << (row_a*KEYPAD_NUM_COLS)) | (common << (row_b*KEYPAD_NUM_COLS));
+			}
+		}
+	}
+	return mask;
+}
+
+static void KEYPAD_pushEvent(uint8 key, KEYPAD_EdgeType edge)
+{
+	uint8 next = (g_queueHead + 1) & (KEYPAD_EVENT_QUEUE_SIZE - 1);
+
+	/* queue full: the event is dropped, the reader is too slow anyway */
+	if(next != g_queueTail)
+	{
+		g_eventQueue[g_queueHead].key = key;
+		g_eventQueue[g_queueHead].edge = edge;
+		g_eventQueue[g_queueHead].time = g_scanTime;
+		g_queueHead = next;
+	}
+}
+
+static void KEYPAD_pushEdges(uint16 edges, KEYPAD_EdgeType edge)
+{
+	uint8 button;
+
+	/* only the changed keys are visited, the loop ends with the last set bit */
+	for(button=0;edges!=0;button++,edges>>=1)
+	{
+		if(edges & 1)
+		{
+			KEYPAD_pushEvent(pgm_read_byte(&g_keyMap[button]),edge);
+		}
+	}
+}
+
+void KEYPAD_init(void)
+{
+	g_queueHead = 0;
+	g_queueTail = 0;
+	g_stableKeys = 0;
+	g_settleCount0 = 0;
+	g_settleCount1 = 0;
+}
+
+/*
+ * Description :
+ * All the keys are processed together with bitwise operations:
+ * - the keys of a ghost rectangle keep their stable state until it is resolved
+ * - a key has to read different from its stable state for KEYPAD_DEBOUNCE_SCANS
+ *   scans in a row before it toggles, a bounce clears its counter
+ * - the toggled keys give the press and release edges, a held key gives one press
+ *   event (no typematic repeat) and any number of keys can be held (n-key rollover)
+ * - a chord event is queued when the stable keys become exactly a chord
+ */
+void KEYPAD_scanTask(void)
+{
+	uint16 keys = KEYPAD_scanMatrix();
+	uint16 ghosts = KEYPAD_ghostMask(keys);
+	uint16 delta, toggled, previous;
+
+	g_scanTime += KEYPAD_SCAN_PERIOD_MS;
+
+	keys = (keys & ~ghosts) | (g_stableKeys & ghosts);
+	delta = keys ^ g_stableKeys;
+
+	/* 2-bit vertical counter: counts the scans with delta set, cleared without it */
+	g_settleCount1 = (g_settleCount1 ^ g_settleCount0) & delta;
+	g_settleCount0 = ~g_settleCount0 & delta;
+	/* the counter wrapped to zero with delta still set: KEYPAD_DEBOUNCE_SCANS reached */
+	toggled = delta & ~(g_settleCount0 | g_settleCount1);
+
+	if(toggled == 0)
+	{
+		return;
+	}
+	previous = g_stableKeys;
+	g_stableKeys ^= toggled;
+
+	KEYPAD_pushEdges(toggled & g_stableKeys,KEYPAD_KEY_PRESSED);
+	KEYPAD_pushEdges(toggled & previous,KEYPAD_KEY_RELEASED);
+
+	if((g_stableKeys == KEYPAD_MAINTENANCE_CHORD) && (previous != KEYPAD_MAINTENANCE_CHORD))
+	{
+		KEYPAD_pushEvent(KEYPAD_MAINTENANCE_KEY,KEYPAD_KEY_PRESSED);
+	}
+}
+
+/*
+ * Description :
+ * Events older than KEYPAD_TYPEAHEAD_TIMEOUT_MS are dropped here, so keys typed
+ * ahead during a busy screen are kept but a key pressed long ago does not act
+ * on a screen the user did not see yet.
+ */
+boolean KEYPAD_poll(KEYPAD_EventType *event)
+{
+	uint8 tail = g_queueTail;
+	uint8 sreg;
+	uint16 now;
+
+	/* the scan time is 16-bit, read it with the interrupts disabled */
+	sreg = SREG;
+	cli();
+	now = g_scanTime;
+	SREG = sreg;
+
+	while(tail != g_queueHead)
+	{
+		event->key = g_eventQueue[tail].key;
+		event->edge = g_eventQueue[tail].edge;
+		event->time = g_eventQueue[tail].time;
+		/* release the entry only after it was copied */
+		tail = (tail + 1) & (KEYPAD_EVENT_QUEUE_SIZE - 1);
+		g_queueTail = tail;
+
+		if((uint16)(now - event->time) <= KEYPAD_TYPEAHEAD_TIMEOUT_MS)
+		{
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+void KEYPAD_flush(void)
+{
+	g_queueTail = g_queueHead;
+}
+
+uint8 KEYPAD_getPressedKey(void)
+{
+	KEYPAD_EventType event;
+
+	while(1)
+	{
+		if(KEYPAD_poll(&event) && (event.edge == KEYPAD_KEY_PRESSED))
+		{
+			return event.key;
+		}
+	}
+}
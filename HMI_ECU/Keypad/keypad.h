@@ -1,46 +1,124 @@
- /******************************************************************************
- *
- * Module: KEYPAD
- *
- * File Name: keypad.h
- *
- * Description: Header file for the Keypad driver
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-
-#ifndef KEYPAD_H_
-#define KEYPAD_H_
-
-#include "std_types.h"
-
-/*******************************************************************************
- *                                Definitions                                  *
- *******************************************************************************/
-
-/* Keypad configurations for number of rows and columns */
-#define KEYPAD_NUM_COLS                  4
-#define KEYPAD_NUM_ROWS                  4
-
-/* Keypad Port Configurations */
-#define KEYPAD_PORT_ID                   PORTA_ID
-
-#define KEYPAD_FIRST_ROW_PIN_ID           PIN0_ID
-#define KEYPAD_FIRST_COLUMN_PIN_ID        PIN4_ID
-
-/* Keypad button logic configurations */
-#define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
-#define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
-
-/*******************************************************************************
- *                      Functions Prototypes                                   *
- *******************************************************************************/
-
-/*
- * Description :
- * Get the Keypad pressed button
- */
-uint8 KEYPAD_getPressedKey(void);
-
-#endif /* KEYPAD_H_ */
+ /******************************************************************************
+ *
+ * Module: KEYPAD
+ *
+ * File Name: keypad.h
+ *
+ * Description: Header file for the Keypad driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+#ifndef KEYPAD_H_
+#define KEYPAD_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Keypad configurations for number of rows and columns */
+#define KEYPAD_NUM_COLS                  4
+#define KEYPAD_NUM_ROWS                  4
+
+/* Keypad Port Configurations */
+#define KEYPAD_PORT_ID                   PORTA_ID
+
+#define KEYPAD_FIRST_ROW_PIN_ID           PIN0_ID
+#define KEYPAD_FIRST_COLUMN_PIN_ID        PIN4_ID
+
+/* Keypad button logic configurations */
+#define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
+#define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
+
+/* Settle time of the rows after a column is driven, before they are read */
+#define KEYPAD_SETTLE_TIME_US            1
+
+/* Period of the background scan, KEYPAD_scanTask must be called at this rate */
+#define KEYPAD_SCAN_PERIOD_MS            5
+
+/*
+ * Number of scans a key has to read the same before a press or a release is accepted.
+ * It is fixed by the 2-bit debounce counters, the settle time is tuned with the scan
+ * period (4 scans * 5 ms = 20 ms).
+ */
+#define KEYPAD_DEBOUNCE_SCANS            4
+#define KEYPAD_DEBOUNCE_TIME_MS          (KEYPAD_DEBOUNCE_SCANS * KEYPAD_SCAN_PERIOD_MS)
+
+#define KEYPAD_NUM_OF_KEYS               (KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS)
+
+/* Bit of a switch in the pressed keys bitmap */
+#define KEYPAD_KEY_BIT(row,col)          (1u << (((row) * KEYPAD_NUM_COLS) + (col)))
+
+/*
+ * Maintenance chord: when exactly these keys are held together a KEYPAD_MAINTENANCE_KEY
+ * press event is queued (after the press events of the keys themselves)
+ */
+#if (KEYPAD_NUM_COLS == 3)
+#define KEYPAD_MAINTENANCE_CHORD         (KEYPAD_KEY_BIT(3,0) | KEYPAD_KEY_BIT(3,2))  /* '*' and '#' */
+#elif (KEYPAD_NUM_COLS == 4)
+#define KEYPAD_MAINTENANCE_CHORD         (KEYPAD_KEY_BIT(1,3) | KEYPAD_KEY_BIT(3,2))  /* '*' and '=' */
+#endif
+#define KEYPAD_MAINTENANCE_KEY           0x80
+
+/* Number of queued key events (type-ahead buffer), must be a power of 2 */
+#define KEYPAD_EVENT_QUEUE_SIZE          16
+
+/* A queued event older than this is stale and dropped (must be below 32768) */
+#define KEYPAD_TYPEAHEAD_TIMEOUT_MS      3000
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+	KEYPAD_KEY_RELEASED,KEYPAD_KEY_PRESSED
+}KEYPAD_EdgeType;
+
+typedef struct
+{
+	uint8 key;              /* the key value, same values as KEYPAD_getPressedKey */
+	KEYPAD_EdgeType edge;   /* pressed or released */
+	uint16 time;            /* scan time of the event in ms, wraps around */
+}KEYPAD_EventType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Clear the key event queue and the debounce state of all keys.
+ */
+void KEYPAD_init(void);
+
+/*
+ * Description :
+ * Scan the whole matrix once, suppress the ghost keys, debounce all the keys and
+ * queue a press/release event for every debounced change and the chord events. Called from a periodic timer callback every
+ * KEYPAD_SCAN_PERIOD_MS, it is the only code that drives the keypad port.
+ */
+void KEYPAD_scanTask(void);
+
+/*
+ * Description :
+ * Non-blocking: take the oldest key event from the queue, stale events are skipped.
+ * Return TRUE if an event was taken, FALSE if the queue is empty.
+ */
+boolean KEYPAD_poll(KEYPAD_EventType *event);
+
+/*
+ * Description :
+ * Drop all the queued key events (the keys typed ahead).
+ */
+void KEYPAD_flush(void);
+
+/*
+ * Description :
+ * Wait for the next key press event and return its key.
+ */
+uint8 KEYPAD_getPressedKey(void);
+
+#endif /* KEYPAD_H_ */
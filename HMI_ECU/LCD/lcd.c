@@ -1,233 +1,1077 @@
- /******************************************************************************
- *
- * Module: LCD
- *
- * File Name: lcd.c
- *
- * Description: Source file for the LCD driver
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-
-#include <util/delay.h> /* For the delay functions */
-#include "common_macros.h" /* To use the macros like SET_BIT */
-#include "lcd.h"
-#include "gpio.h"
-
-/*******************************************************************************
- *                      Functions Definitions                                  *
- *******************************************************************************/
-
-/*
- * Description :
- * Initialize the LCD:
- * 1. Setup the LCD pins directions by use the GPIO driver.
- * 2. Setup the LCD Data Mode 4-bits or 8-bits.
- */
-void LCD_init(void)
-{
-	/* Configure the direction for RS, RW and E pins as output pins */
-	GPIO_setupPinDirection(LCD_RS_PORT_ID,LCD_RS_PIN_ID,PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_RW_PORT_ID,LCD_RW_PIN_ID,PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_E_PORT_ID,LCD_E_PIN_ID,PIN_OUTPUT);
-
-#if (LCD_DATA_BITS_MODE == 4)
-
-	/* Configure 4 pins in the data port as output pins */
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID,PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+1,PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+2,PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+3,PIN_OUTPUT);
-
-	LCD_sendCommand(LCD_GO_TO_HOME);
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE); /* use 2-line lcd + 4-bit Data Mode + 5*7 dot display Mode */
-
-#elif (LCD_DATA_BITS_MODE == 8)
-	/* Configure the data port as output port */
-	GPIO_setupPortDirection(LCD_DATA_PORT_ID,PORT_OUTPUT);
-	LCD_sendCommand(LCD_TWO_LINES_EIGHT_BITS_MODE); /* use 2-line lcd + 8-bit Data Mode + 5*7 dot display Mode */
-#endif
-
-	LCD_sendCommand(LCD_CURSOR_OFF); /* cursor off */
-	LCD_sendCommand(LCD_CLEAR_COMMAND); /* clear LCD at the beginning */
-}
-
-/*
- * Description :
- * Send the required command to the screen
- */
-void LCD_sendCommand(uint8 command)
-{
-	uint8 lcd_port_value = 0;
-	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
-	GPIO_writePin(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW); /* write data to LCD so RW=0 */
-	_delay_ms(1); /* delay for processing Tas = 50ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-#if (LCD_DATA_BITS_MODE == 4)
-	/* out the last 4 bits of the required command to the data bus D4 --> D7 */
-	lcd_port_value = GPIO_readPort(LCD_DATA_PORT_ID);
-#ifdef LCD_LAST_PORT_PINS
-	lcd_port_value = (lcd_port_value & 0x0F) | (command & 0xF0);
-#else
-	lcd_port_value = (lcd_port_value & 0xF0) | ((command & 0xF0) >> 4);
-#endif
-	GPIO_writePort(LCD_DATA_PORT_ID,lcd_port_value);
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-	/* out the first 4 bits of the required command to the data bus D4 --> D7 */
-	lcd_port_value = GPIO_readPort(LCD_DATA_PORT_ID);
-#ifdef LCD_LAST_PORT_PINS
-	lcd_port_value = (lcd_port_value & 0x0F) | ((command & 0x0F) << 4);
-#else
-	lcd_port_value = (lcd_port_value & 0xF0) | (command & 0x0F);
-#endif
-	GPIO_writePort(LCD_DATA_PORT_ID,lcd_port_value);
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-
-#elif (LCD_DATA_BITS_MODE == 8)
-	GPIO_writePort(LCD_DATA_PORT_ID,command); /* out the required command to the data bus D0 --> D7 */
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-#endif
-}
-
-/*
- * Description :
- * Display the required character on the screen
- */
-void LCD_displayCharacter(uint8 data)
-{
-	uint8 lcd_port_value = 0;
-	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_HIGH); /* Data Mode RS=1 */
-	GPIO_writePin(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW); /* write data to LCD so RW=0 */
-	_delay_ms(1); /* delay for processing Tas = 50ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-#if (LCD_DATA_BITS_MODE == 4)
-	/* out the last 4 bits of the required data to the data bus D4 --> D7 */
-	lcd_port_value = GPIO_readPort(LCD_DATA_PORT_ID);
-#ifdef LCD_LAST_PORT_PINS
-	lcd_port_value = (lcd_port_value & 0x0F) | (data & 0xF0);
-#else
-	lcd_port_value = (lcd_port_value & 0xF0) | ((data & 0xF0) >> 4);
-#endif
-	GPIO_writePort(LCD_DATA_PORT_ID,lcd_port_value);
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-	/* out the first 4 bits of the required data to the data bus D4 --> D7 */
-	lcd_port_value = GPIO_readPort(LCD_DATA_PORT_ID);
-#ifdef LCD_LAST_PORT_PINS
-	lcd_port_value = (lcd_port_value & 0x0F) | ((data & 0x0F) << 4);
-#else
-	lcd_port_value = (lcd_port_value & 0xF0) | (data & 0x0F);
-#endif
-	GPIO_writePort(LCD_DATA_PORT_ID,lcd_port_value);
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-
-#elif (LCD_DATA_BITS_MODE == 8)
-	GPIO_writePort(LCD_DATA_PORT_ID,data); /* out the required data to the data bus D0 --> D7 */
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-#endif
-}
-
-/*
- * Description :
- * Display the required string on the screen
- */
-void LCD_displayString(const char *Str)
-{
-	uint8 i = 0;
-	while(Str[i] != '\0')
-	{
-		LCD_displayCharacter(Str[i]);
-		i++;
-	}
-	/***************** Another Method ***********************
-	while((*Str) != '\0')
-	{
-		LCD_displayCharacter(*Str);
-		Str++;
-	}		
-	*********************************************************/
-}
-
-/*
- * Description :
- * Move the cursor to a specified row and column index on the screen
- */
-void LCD_moveCursor(uint8 row,uint8 col)
-{
-	uint8 lcd_memory_address;
-	
-	/* Calculate the required address in the LCD DDRAM */
-	switch(row)
-	{
-		case 0:
-			lcd_memory_address=col;
-				break;
-		case 1:
-			lcd_memory_address=col+0x40;
-				break;
-		case 2:
-			lcd_memory_address=col+0x10;
-				break;
-		case 3:
-			lcd_memory_address=col+0x50;
-				break;
-	}					
-	/* Move the LCD cursor to this specific address */
-	LCD_sendCommand(lcd_memory_address | LCD_SET_CURSOR_LOCATION);
-}
-
-/*
- * Description :
- * Display the required string in a specified row and column index on the screen
- */
-void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
-{
-	LCD_moveCursor(row,col); /* go to to the required LCD position */
-	LCD_displayString(Str); /* display the string */
-}
-
-/*
- * Description :
- * Display the required decimal value on the screen
- */
-void LCD_intgerToString(int data)
-{
-   char buff[16]; /* String to hold the ascii result */
-   itoa(data,buff,10); /* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
-   LCD_displayString(buff); /* Display the string */
-}
-
-/*
- * Description :
- * Send the clear screen command
- */
-void LCD_clearScreen(void)
-{
-	LCD_sendCommand(LCD_CLEAR_COMMAND); /* Send clear display command */
-}
+ /******************************************************************************
+ *
+ * Module: LCD
+ *
+ * File Name: lcd.c
+ *
+ * Description: Source file for the LCD driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+#include <util/delay.h> /* For the delay functions */
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include "lcd.h"
+#include "gpio.h" /* The static pin API: the LCD pins are fixed */
+#include "num_format.h" /* To write the numbers without itoa */
+#include <avr/pgmspace.h> /* To read the strings kept in flash */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/*
+ * Delay between two steps of a transfer (RS/RW setup, enable pulse width, data setup
+ * and hold, all below 1 us). The execution time of the instruction is waited apart.
+ */
+#define LCD_TIMING_DELAY()             _delay_us(1)
+
+#if (LCD_USE_BUSY_FLAG == 0)
+/*
+ * Without the busy flag the execution time is counted in calls of the LCD task (1 ms
+ * Timer0 tick), the task skips a call instead of blocking the interrupt. Clear and
+ * return home take 1.52 ms, the other instructions 37 us.
+ */
+#define LCD_TASK_PERIOD_MS             1
+#define LCD_EXECUTION_PERIODS          1
+#define LCD_LONG_EXECUTION_PERIODS     2
+#endif
+
+/* Busy flag polling: the flag is on D7, a missing LCD must not hang the system */
+#define LCD_BUSY_FLAG_PIN_ID           PIN7_ID
+#define LCD_BUSY_POLL_DELAY_US         10
+#define LCD_BUSY_POLL_LIMIT            250
+
+/* Before the function set the busy flag can not be read, wait the longest execution time */
+#define LCD_INIT_COMMAND_DELAY_MS      2
+
+/*
+ * Busy flag polls allowed in one LCD_task before it gives the bus up until the next
+ * call, enough for the 37 us execution time of a write
+ */
+#define LCD_TASK_POLL_LIMIT            5
+
+#define LCD_NUM_CELLS                  (LCD_NUM_ROWS * LCD_NUM_COLS)
+#define LCD_ADDRESS_UNKNOWN            0xFF
+
+/* Transfer queue entries: the byte to write and the RS level (data or instruction) */
+#define LCD_QUEUE_DATA                 0x0100
+#define LCD_QUEUE_COMMAND              0x0000
+#define LCD_QUEUE_GLYPH                0x0200  /* low byte: CGRAM slot to upload */
+
+/* CGRAM: 8 glyphs of 8 rows, the character codes 8-15 show the same glyphs as 0-7 */
+#define LCD_SET_CGRAM_ADDRESS          0x40
+#define LCD_CGRAM_ADDRESS_MASK         0x3F
+#define LCD_NUM_OF_GLYPHS              8
+#define LCD_GLYPH_HEIGHT               8
+#define LCD_GLYPH_CODE_OFFSET          8       /* code 0 would end a string */
+#define LCD_SOLID_BLOCK_CODE           0xFF    /* all pixels set, in the character ROM */
+
+/* Dirty bitmap access, one bit per cell */
+#define LCD_SET_DIRTY(cell)            SET_BIT(g_dirty[(cell) >> 3],((cell) & 7))
+#define LCD_CLEAR_DIRTY(cell)          CLEAR_BIT(g_dirty[(cell) >> 3],((cell) & 7))
+#define LCD_IS_DIRTY(cell)             BIT_IS_SET(g_dirty[(cell) >> 3],((cell) & 7))
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for writing one instruction byte to the LCD
+ */
+static void LCD_writeCommand(uint8 command);
+
+/*
+ * Function responsible for writing one data byte to the LCD at its own cursor
+ */
+static void LCD_writeData(uint8 data);
+
+/*
+ * Function responsible for sending one init instruction, waiting until the LCD is ready
+ */
+static void LCD_initCommand(uint8 command);
+
+/*
+ * Function responsible for adding a transfer to the queue
+ */
+static void LCD_enqueue(uint16 entry);
+
+/*
+ * Function responsible for sending the next transfer of the dirty cells
+ */
+static boolean LCD_drawStep(void);
+
+/*
+ * Function responsible for sending the next transfer of a glyph upload
+ */
+static boolean LCD_uploadStep(uint8 slot);
+
+/*
+ * Function responsible for writing one character to the shadow framebuffer at the cursor
+ */
+static void LCD_putCharacter(uint8 data);
+
+/*
+ * Function responsible for returning the DDRAM address of the first cell of a row
+ */
+static uint8 LCD_rowAddress(uint8 row);
+
+/*
+ * Function responsible for waiting until the LCD can take the next transfer
+ */
+static boolean LCD_waitReady(uint8 polls);
+
+/*
+ * Function responsible for sending the next transfers, waiting in place or not
+ */
+static void LCD_runTask(boolean inPlace);
+
+#if (LCD_USE_BUSY_FLAG == 1)
+/*
+ * Function responsible for reading the busy flag of the LCD
+ */
+static uint8 LCD_isBusy(void);
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Shadow framebuffer: the characters the screen should show, row after row */
+static uint8 g_shadow[LCD_NUM_CELLS];
+
+/* Cells of the shadow framebuffer that differ from the LCD */
+static uint8 g_dirty[(LCD_NUM_CELLS + 7) / 8];
+
+/* Cursor of the drawing functions, index of a cell in the shadow framebuffer */
+static uint8 g_cursorCell = 0;
+
+/* DDRAM address of the LCD own cursor, it increments after every data write */
+static uint8 g_lcdAddress = LCD_ADDRESS_UNKNOWN;
+
+/* The busy flag is valid once the function set command is executed */
+static boolean g_busyFlagValid = FALSE;
+
+#if (LCD_USE_BUSY_FLAG == 0)
+/* Task periods the LCD still needs to execute the last instruction */
+static volatile uint8 g_executionPeriods = 0;
+
+/* Set while the init or LCD_flush sends, they may wait the execution time in place */
+static boolean g_waitInPlace = FALSE;
+#endif
+
+/*
+ * Transfer queue of the explicit commands: the application adds at the head and the
+ * LCD task removes from the tail, the same single producer/single consumer scheme as
+ * the keypad event queue.
+ */
+static volatile uint16 g_queue[LCD_QUEUE_SIZE];
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+/* Next cell the draw step looks at, the dirty cells are sent in screen order from here */
+static uint8 g_nextCell = 0;
+
+/* Set while an LCD_task runs, an interrupted LCD_flush must not be re-entered */
+static volatile boolean g_taskActive = FALSE;
+
+/* Set by a transfer, cleared with the notification once everything is sent */
+static boolean g_transferDone = FALSE;
+
+/* Address counter in the CGRAM (instead of the DDRAM) after a CGRAM address command */
+static uint8 g_cgramAddress = LCD_ADDRESS_UNKNOWN;
+
+/*
+ * Glyph cache: the flash bitmap loaded in every CGRAM slot, how many users hold it
+ * and when it was last acquired (the least recently used free slot is replaced)
+ */
+static const uint8 *g_glyphSource[LCD_NUM_OF_GLYPHS];
+static uint8 g_glyphRefCount[LCD_NUM_OF_GLYPHS];
+static uint16 g_glyphLastUse[LCD_NUM_OF_GLYPHS];
+static uint16 g_glyphClock = 0;
+
+/* Next row of the glyph being uploaded */
+static uint8 g_uploadRow = 0;
+
+/* Progress bar cells filled 1 to 4 pixel columns (an empty cell is ' ', a full one the solid block) */
+static const uint8 g_barGlyphs[LCD_GLYPH_WIDTH - 1][LCD_GLYPH_HEIGHT] PROGMEM =
+{
+	{0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10},
+	{0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18},
+	{0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C},
+	{0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E}
+};
+
+/* Completion notification */
+static void (*volatile g_idleCallBackPtr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Initialize the LCD:
+ * 1. Setup the LCD pins directions by use the GPIO driver.
+ * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ */
+void LCD_init(void)
+{
+	uint8 cell;
+
+	g_busyFlagValid = FALSE;
+#if (LCD_USE_BUSY_FLAG == 0)
+	g_waitInPlace = TRUE;
+	g_executionPeriods = LCD_LONG_EXECUTION_PERIODS;
+#endif
+	/* Configure the direction for RS, RW and E pins as output pins */
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_RS_PORT_ID,LCD_RS_PIN_ID,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_RW_PORT_ID,LCD_RW_PIN_ID,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_E_PORT_ID,LCD_E_PIN_ID,PIN_OUTPUT);
+
+#if (LCD_DATA_BITS_MODE == 4)
+
+	/* Configure 4 pins in the data port as output pins */
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+1,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+2,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+3,PIN_OUTPUT);
+
+	LCD_initCommand(LCD_GO_TO_HOME);
+	LCD_initCommand(LCD_TWO_LINES_FOUR_BITS_MODE); /* use 2-line lcd + 4-bit Data Mode + 5*7 dot display Mode */
+	_delay_ms(LCD_INIT_COMMAND_DELAY_MS);
+
+#elif (LCD_DATA_BITS_MODE == 8)
+	/* Configure the data port as output port */
+	GPIO_STATIC_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_OUTPUT);
+	LCD_initCommand(LCD_TWO_LINES_EIGHT_BITS_MODE); /* use 2-line lcd + 8-bit Data Mode + 5*7 dot display Mode */
+	_delay_ms(LCD_INIT_COMMAND_DELAY_MS);
+#endif
+	g_busyFlagValid = TRUE;
+
+	LCD_initCommand(LCD_CURSOR_OFF); /* cursor off */
+	LCD_initCommand(LCD_CLEAR_COMMAND); /* clear LCD at the beginning */
+#if (LCD_USE_BUSY_FLAG == 0)
+	/* the next call may come from the timer at once, it must not count this execution */
+	LCD_waitReady(LCD_BUSY_POLL_LIMIT);
+	g_waitInPlace = FALSE;
+#endif
+
+	g_queueHead = 0;
+	g_queueTail = 0;
+	g_nextCell = 0;
+	g_uploadRow = 0;
+	for(cell=0;cell<LCD_NUM_OF_GLYPHS;cell++)
+	{
+		g_glyphSource[cell] = NULL_PTR;
+		g_glyphRefCount[cell] = 0;
+	}
+
+	/* the LCD is blank now, so is the shadow framebuffer */
+	for(cell=0;cell<LCD_NUM_CELLS;cell++)
+	{
+		g_shadow[cell] = ' ';
+		LCD_CLEAR_DIRTY(cell);
+	}
+	g_cursorCell = 0;
+}
+
+#if (LCD_USE_BUSY_FLAG == 1)
+/*
+ * Description :
+ * Read the busy flag: RS=0 and RW=1 put the flag on D7 while E is high.
+ * In 4-bit mode the second nibble (address counter) is clocked out and ignored.
+ */
+static uint8 LCD_isBusy(void)
+{
+	uint8 busy;
+
+	/* the LCD drives the data bus during the read */
+#if (LCD_DATA_BITS_MODE == 4)
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID,PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+1,PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+2,PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+3,PIN_INPUT);
+#else
+	GPIO_STATIC_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_INPUT);
+#endif
+	GPIO_STATIC_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
+	GPIO_STATIC_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_HIGH); /* read from LCD so RW=1 */
+	_delay_us(1); /* delay for processing Tas = 50ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tddr = 160ns */
+
+#if (LCD_DATA_BITS_MODE == 4)
+	busy = GPIO_STATIC_READ_PIN(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+3); /* D7 is the last data pin */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Tc - Tpw = 500ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tpw = 230ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+1,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+2,PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_FIRST_DATA_PIN_ID+3,PIN_OUTPUT);
+#else
+	busy = GPIO_STATIC_READ_PIN(LCD_DATA_PORT_ID,LCD_BUSY_FLAG_PIN_ID);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+
+	GPIO_STATIC_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_OUTPUT);
+#endif
+	GPIO_STATIC_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW); /* back to write RW=0 */
+	_delay_us(1); /* delay for processing Th = 10ns */
+
+	return busy;
+}
+#endif
+
+/*
+ * Description :
+ * Wait until the LCD can take the next transfer: poll the busy flag once it is valid,
+ * before that wait a fixed time. Without the busy flag wait the task periods left of
+ * the execution time, in place only for the init and LCD_flush.
+ * Return FALSE if the LCD is still busy after the given number of polls.
+ */
+static boolean LCD_waitReady(uint8 polls)
+{
+#if (LCD_USE_BUSY_FLAG == 1)
+	if(!g_busyFlagValid)
+	{
+		_delay_ms(LCD_INIT_COMMAND_DELAY_MS);
+		return TRUE;
+	}
+	while(LCD_isBusy())
+	{
+		if(--polls == 0)
+		{
+			return FALSE;
+		}
+		_delay_us(LCD_BUSY_POLL_DELAY_US);
+	}
+	return TRUE;
+#else
+	if(g_waitInPlace)
+	{
+		while(g_executionPeriods != 0)
+		{
+			_delay_ms(LCD_TASK_PERIOD_MS);
+			g_executionPeriods--;
+		}
+	}
+	return (g_executionPeriods == 0);
+#endif
+}
+
+/*
+ * Description :
+ * Send one instruction during the init, before the LCD task runs
+ */
+static void LCD_initCommand(uint8 command)
+{
+	LCD_waitReady(LCD_BUSY_POLL_LIMIT);
+	LCD_writeCommand(command);
+}
+
+/*
+ * Description :
+ * Write one instruction byte to the LCD, the caller waited until it is ready
+ */
+static void LCD_writeCommand(uint8 command)
+{
+	GPIO_STATIC_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
+	GPIO_STATIC_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW); /* write data to LCD so RW=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Tas = 50ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	LCD_TIMING_DELAY(); /* delay for processing Tpw - Tdws = 190ns */
+
+#if (LCD_DATA_BITS_MODE == 4)
+	uint8 lcd_port_value;
+
+	/* out the last 4 bits of the required command to the data bus D4 --> D7 */
+	lcd_port_value = GPIO_STATIC_READ_PORT(LCD_DATA_PORT_ID);
+#ifdef LCD_LAST_PORT_PINS
+	lcd_port_value = (lcd_port_value & 0x0F) | (command & 0xF0);
+#else
+	lcd_port_value = (lcd_port_value & 0xF0) | ((command & 0xF0) >> 4);
+#endif
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID,lcd_port_value);
+
+	LCD_TIMING_DELAY(); /* delay for processing Tdsw = 100ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Th = 13ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	LCD_TIMING_DELAY(); /* delay for processing Tpw - Tdws = 190ns */
+
+	/* out the first 4 bits of the required command to the data bus D4 --> D7 */
+	lcd_port_value = GPIO_STATIC_READ_PORT(LCD_DATA_PORT_ID);
+#ifdef LCD_LAST_PORT_PINS
+	lcd_port_value = (lcd_port_value & 0x0F) | ((command & 0x0F) << 4);
+#else
+	lcd_port_value = (lcd_port_value & 0xF0) | (command & 0x0F);
+#endif
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID,lcd_port_value);
+
+	LCD_TIMING_DELAY(); /* delay for processing Tdsw = 100ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Th = 13ns */
+
+#elif (LCD_DATA_BITS_MODE == 8)
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID,command); /* out the required command to the data bus D0 --> D7 */
+	LCD_TIMING_DELAY(); /* delay for processing Tdsw = 100ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Th = 13ns */
+#endif
+
+	/* keep track of the LCD own cursor (in the DDRAM or the CGRAM), other commands may move it */
+	g_lcdAddress = LCD_ADDRESS_UNKNOWN;
+	g_cgramAddress = LCD_ADDRESS_UNKNOWN;
+	if(command & LCD_SET_CURSOR_LOCATION)
+	{
+		g_lcdAddress = command & ~LCD_SET_CURSOR_LOCATION;
+	}
+	else if(command & LCD_SET_CGRAM_ADDRESS)
+	{
+		g_cgramAddress = command & LCD_CGRAM_ADDRESS_MASK;
+	}
+
+#if (LCD_USE_BUSY_FLAG == 0)
+	if((command == LCD_CLEAR_COMMAND) || (command == LCD_GO_TO_HOME))
+	{
+		g_executionPeriods = LCD_LONG_EXECUTION_PERIODS;
+	}
+	else
+	{
+		g_executionPeriods = LCD_EXECUTION_PERIODS;
+	}
+#endif
+}
+
+/*
+ * Description :
+ * Write one data byte to the LCD at its own cursor, the caller waited until it is ready
+ */
+static void LCD_writeData(uint8 data)
+{
+	GPIO_STATIC_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_HIGH); /* Data Mode RS=1 */
+	GPIO_STATIC_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW); /* write data to LCD so RW=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Tas = 50ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	LCD_TIMING_DELAY(); /* delay for processing Tpw - Tdws = 190ns */
+
+#if (LCD_DATA_BITS_MODE == 4)
+	uint8 lcd_port_value;
+
+	/* out the last 4 bits of the required data to the data bus D4 --> D7 */
+	lcd_port_value = GPIO_STATIC_READ_PORT(LCD_DATA_PORT_ID);
+#ifdef LCD_LAST_PORT_PINS
+	lcd_port_value = (lcd_port_value & 0x0F) | (data & 0xF0);
+#else
+	lcd_port_value = (lcd_port_value & 0xF0) | ((data & 0xF0) >> 4);
+#endif
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID,lcd_port_value);
+
+	LCD_TIMING_DELAY(); /* delay for processing Tdsw = 100ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Th = 13ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	LCD_TIMING_DELAY(); /* delay for processing Tpw - Tdws = 190ns */
+
+	/* out the first 4 bits of the required data to the data bus D4 --> D7 */
+	lcd_port_value = GPIO_STATIC_READ_PORT(LCD_DATA_PORT_ID);
+#ifdef LCD_LAST_PORT_PINS
+	lcd_port_value = (lcd_port_value & 0x0F) | ((data & 0x0F) << 4);
+#else
+	lcd_port_value = (lcd_port_value & 0xF0) | (data & 0x0F);
+#endif
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID,lcd_port_value);
+
+	LCD_TIMING_DELAY(); /* delay for processing Tdsw = 100ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Th = 13ns */
+
+#elif (LCD_DATA_BITS_MODE == 8)
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID,data); /* out the required data to the data bus D0 --> D7 */
+	LCD_TIMING_DELAY(); /* delay for processing Tdsw = 100ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	LCD_TIMING_DELAY(); /* delay for processing Th = 13ns */
+#endif
+
+	if(g_lcdAddress != LCD_ADDRESS_UNKNOWN)
+	{
+		g_lcdAddress++;
+	}
+	else if(g_cgramAddress != LCD_ADDRESS_UNKNOWN)
+	{
+		g_cgramAddress = (g_cgramAddress + 1) & LCD_CGRAM_ADDRESS_MASK;
+	}
+
+#if (LCD_USE_BUSY_FLAG == 0)
+	g_executionPeriods = LCD_EXECUTION_PERIODS;
+#endif
+}
+
+/*
+ * Description :
+ * Put one character in the shadow framebuffer at the cursor, characters beyond
+ * the end of the row are dropped
+ */
+static void LCD_putCharacter(uint8 data)
+{
+	if(g_cursorCell >= LCD_NUM_CELLS)
+	{
+		return;
+	}
+	if(g_shadow[g_cursorCell] != data)
+	{
+		g_shadow[g_cursorCell] = data;
+		LCD_SET_DIRTY(g_cursorCell);
+	}
+	g_cursorCell++;
+	/* stay out of the next row until the cursor is moved */
+	if((g_cursorCell % LCD_NUM_COLS) == 0)
+	{
+		g_cursorCell = LCD_NUM_CELLS;
+	}
+}
+
+/*
+ * Description :
+ * Display the required character on the screen at the cursor position
+ */
+void LCD_displayCharacter(uint8 data)
+{
+	LCD_putCharacter(data);
+}
+
+/*
+ * Description :
+ * Display the required string on the screen
+ */
+void LCD_displayString(const char *Str)
+{
+	uint8 i = 0;
+	while(Str[i] != '\0')
+	{
+		LCD_putCharacter(Str[i]);
+		i++;
+	}
+	/***************** Another Method ***********************
+	while((*Str) != '\0')
+	{
+		LCD_displayCharacter(*Str);
+		Str++;
+	}		
+	*********************************************************/
+}
+
+/*
+ * Description :
+ * Display a string kept in flash (PROGMEM) on the screen
+ */
+void LCD_displayFlashString(const char *Str)
+{
+	char character;
+
+	while((character = pgm_read_byte(Str)) != '\0')
+	{
+		LCD_putCharacter(character);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Display a string kept in flash (PROGMEM) in a specified row and column index on the screen
+ */
+void LCD_displayFlashStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col); /* go to to the required LCD position */
+	LCD_displayFlashString(Str); /* display the string */
+}
+
+/*
+ * Description :
+ * Return the DDRAM address of the first cell of a row
+ */
+static uint8 LCD_rowAddress(uint8 row)
+{
+	uint8 lcd_memory_address = 0;
+
+	/* rows 0 and 2 start at 0x00, rows 1 and 3 at 0x40, rows 2 and 3 follow rows 0 and 1 */
+	if(row & 1)
+	{
+		lcd_memory_address = 0x40;
+	}
+	if(row & 2)
+	{
+		lcd_memory_address += LCD_NUM_COLS;
+	}
+	return lcd_memory_address;
+}
+
+/*
+ * Description :
+ * Move the cursor to a specified row and column index on the screen,
+ * the LCD itself is updated by the next flush
+ */
+void LCD_moveCursor(uint8 row,uint8 col)
+{
+	if((row < LCD_NUM_ROWS) && (col < LCD_NUM_COLS))
+	{
+		g_cursorCell = (row * LCD_NUM_COLS) + col;
+	}
+	else
+	{
+		g_cursorCell = LCD_NUM_CELLS;
+	}
+}
+
+/*
+ * Description :
+ * Display the required string in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col); /* go to to the required LCD position */
+	LCD_displayString(Str); /* display the string */
+}
+
+/*
+ * Description :
+ * Display the required decimal value on the screen
+ */
+void LCD_intgerToString(int data)
+{
+   char buff[FORMAT_BUFFER_SIZE]; /* String to hold the ascii result */
+   FORMAT_signed(buff,(sint16)data,0,FORMAT_PAD_SPACE); /* Convert the data to its corresponding ASCII value without division */
+   LCD_displayString(buff); /* Display the string */
+}
+
+/*
+ * Description :
+ * Display an unsigned value right aligned in a field of width characters
+ * in a specified row and column index on the screen
+ */
+void LCD_displayNumberRowColumn(uint8 row,uint8 col,uint16 data,uint8 width,char pad)
+{
+	char buff[FORMAT_BUFFER_SIZE];
+
+	/* a field wider than the buffer is padded with spaces written before the number */
+	while(width >= FORMAT_BUFFER_SIZE)
+	{
+		LCD_displayStringRowColumn(row,col++," ");
+		width--;
+		pad = FORMAT_PAD_SPACE;
+	}
+	FORMAT_unsigned(buff,data,width,pad);
+	LCD_displayStringRowColumn(row,col,buff);
+}
+
+/*
+ * Description :
+ * Display a countdown in seconds as mm:ss in a specified row and column index on the screen
+ */
+void LCD_displayCountdownRowColumn(uint8 row,uint8 col,uint16 seconds)
+{
+	char buff[FORMAT_BUFFER_SIZE];
+
+	FORMAT_mmss(buff,seconds);
+	LCD_displayStringRowColumn(row,col,buff);
+}
+
+/*
+ * Description :
+ * Clear the screen and move the cursor home, the LCD itself is updated by the
+ * next flush (normally by the next string written on the cleared screen)
+ */
+void LCD_clearScreen(void)
+{
+	uint8 cell;
+
+	/*
+	 * No clear command: it blanks the LCD and costs 1.5 ms, while the next screen
+	 * usually rewrites most of the cells. Only the cells that change are sent.
+	 */
+	for(cell=0;cell<LCD_NUM_CELLS;cell++)
+	{
+		if(g_shadow[cell] != ' ')
+		{
+			g_shadow[cell] = ' ';
+			LCD_SET_DIRTY(cell);
+		}
+	}
+	g_cursorCell = 0;
+}
+
+/*
+ * Description :
+ * Queue a command for the LCD task, wait only if the queue is full
+ */
+void LCD_sendCommand(uint8 command)
+{
+	LCD_enqueue(LCD_QUEUE_COMMAND | command);
+}
+
+static void LCD_enqueue(uint16 entry)
+{
+	uint8 next = (g_queueHead + 1) & (LCD_QUEUE_SIZE - 1);
+
+	/* the task empties the queue from the timer interrupt */
+	while(next == g_queueTail)
+	{
+	}
+	g_queue[g_queueHead] = entry;
+	g_queueHead = next;
+}
+
+/*
+ * Description :
+ * Send one transfer for the dirty cells, in screen order starting at g_nextCell.
+ * A cursor command is sent only when the dirty cell is not where the LCD cursor
+ * already is, a short clean gap is re-written instead.
+ * Return FALSE if there is no dirty cell.
+ */
+static boolean LCD_drawStep(void)
+{
+	uint8 i,cell,row,address,row_address;
+
+	cell = g_nextCell;
+	for(i=0;i<LCD_NUM_CELLS;i++,cell++)
+	{
+		if(cell >= LCD_NUM_CELLS)
+		{
+			cell = 0;
+		}
+		if(LCD_IS_DIRTY(cell))
+		{
+			break;
+		}
+	}
+	if(i == LCD_NUM_CELLS)
+	{
+		return FALSE;
+	}
+
+	row = cell / LCD_NUM_COLS;
+	row_address = LCD_rowAddress(row);
+	address = row_address + (cell - (row * LCD_NUM_COLS));
+
+	if(address == g_lcdAddress)
+	{
+		/* clear before reading: a character written meanwhile stays dirty */
+		LCD_CLEAR_DIRTY(cell);
+		LCD_writeData(g_shadow[cell]);
+		g_nextCell = cell + 1;
+	}
+	else if((g_lcdAddress >= row_address) && (g_lcdAddress < address) &&
+			((address - g_lcdAddress) <= LCD_MAX_REWRITE_GAP))
+	{
+		/* re-write the first cell of the gap, it is on this row */
+		cell -= address - g_lcdAddress;
+		LCD_CLEAR_DIRTY(cell);
+		LCD_writeData(g_shadow[cell]);
+	}
+	else
+	{
+		LCD_writeCommand(address | LCD_SET_CURSOR_LOCATION);
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Send one transfer of the upload of a CGRAM slot: the CGRAM address command, then
+ * one row per call. Uploads of consecutive slots run on without a new address
+ * command, the CGRAM address counter increments like the DDRAM one.
+ * Return TRUE once the last row is sent.
+ */
+static boolean LCD_uploadStep(uint8 slot)
+{
+	uint8 address = (uint8)(slot * LCD_GLYPH_HEIGHT) + g_uploadRow;
+
+	if(address != g_cgramAddress)
+	{
+		LCD_writeCommand(LCD_SET_CGRAM_ADDRESS | address);
+		return FALSE;
+	}
+	LCD_writeData(pgm_read_byte(&g_glyphSource[slot][g_uploadRow]));
+	if(++g_uploadRow < LCD_GLYPH_HEIGHT)
+	{
+		return FALSE;
+	}
+	g_uploadRow = 0;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Send the next transfers from the periodic timer callback, never waiting in place
+ */
+void LCD_task(void)
+{
+	LCD_runTask(FALSE);
+}
+
+/*
+ * Description :
+ * Send up to LCD_TRANSFERS_PER_TASK transfers: the queued commands first, then the
+ * dirty cells. It gives the bus up as soon as the LCD stays busy. Without the busy
+ * flag a call from the timer counts one task period of the execution time.
+ */
+static void LCD_runTask(boolean inPlace)
+{
+	uint8 transfers;
+	uint16 entry;
+
+	if(g_taskActive)
+	{
+		return;
+	}
+	g_taskActive = TRUE;
+#if (LCD_USE_BUSY_FLAG == 0)
+	g_waitInPlace = inPlace;
+	if(!inPlace && (g_executionPeriods != 0))
+	{
+		g_executionPeriods--;
+	}
+#endif
+
+	for(transfers=0;transfers<LCD_TRANSFERS_PER_TASK;transfers++)
+	{
+		if(LCD_isIdle())
+		{
+			if(g_transferDone)
+			{
+				g_transferDone = FALSE;
+				if(g_idleCallBackPtr != NULL_PTR)
+				{
+					(*g_idleCallBackPtr)();
+				}
+			}
+			break;
+		}
+		if(!LCD_waitReady(LCD_TASK_POLL_LIMIT))
+		{
+			break;
+		}
+		if(g_queueTail != g_queueHead)
+		{
+			entry = g_queue[g_queueTail];
+			if(entry & LCD_QUEUE_GLYPH)
+			{
+				/* the entry stays queued until the last row of the glyph is sent */
+				if(!LCD_uploadStep((uint8)entry))
+				{
+					g_transferDone = TRUE;
+					continue;
+				}
+			}
+			else if(entry & LCD_QUEUE_DATA)
+			{
+				LCD_writeData((uint8)entry);
+			}
+			else
+			{
+				LCD_writeCommand((uint8)entry);
+			}
+			g_queueTail = (g_queueTail + 1) & (LCD_QUEUE_SIZE - 1);
+		}
+		else
+		{
+			LCD_drawStep();
+		}
+		g_transferDone = TRUE;
+	}
+#if (LCD_USE_BUSY_FLAG == 0)
+	/* the next call may come from the timer at once, it must not count this execution */
+	LCD_waitReady(LCD_BUSY_POLL_LIMIT);
+	g_waitInPlace = FALSE;
+#endif
+	g_taskActive = FALSE;
+}
+
+/*
+ * Description :
+ * Return TRUE if there is no queued command and no dirty cell
+ */
+boolean LCD_isIdle(void)
+{
+	uint8 i;
+
+	if(g_queueTail != g_queueHead)
+	{
+		return FALSE;
+	}
+	for(i=0;i<sizeof(g_dirty);i++)
+	{
+		if(g_dirty[i] != 0)
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Set the function called by the LCD task once everything is on the LCD
+ */
+void LCD_setIdleCallBack(void(*a_ptr)(void))
+{
+	g_idleCallBackPtr = a_ptr;
+}
+
+/*
+ * Description :
+ * Flush barrier: wait until everything written before is on the LCD. The task is run
+ * from here too, so the barrier works before the timer is started.
+ */
+void LCD_flush(void)
+{
+	while(!LCD_isIdle())
+	{
+		LCD_runTask(TRUE);
+	}
+}
+
+/*
+ * Description :
+ * Get a character code showing a glyph (8 rows of 5 pixels, kept in flash).
+ * A glyph already in the CGRAM is shared, otherwise the least recently used slot
+ * nobody holds is replaced and the upload is queued before the next cells.
+ * Return LCD_NO_GLYPH if all the slots are held.
+ */
+uint8 LCD_acquireGlyph(const uint8 *glyph)
+{
+	uint8 slot;
+	uint8 victim = LCD_NO_GLYPH;
+	uint16 age = 0;
+
+	g_glyphClock++;
+	for(slot=0;slot<LCD_NUM_OF_GLYPHS;slot++)
+	{
+		if(g_glyphSource[slot] == glyph)
+		{
+			g_glyphRefCount[slot]++;
+			g_glyphLastUse[slot] = g_glyphClock;
+			return slot + LCD_GLYPH_CODE_OFFSET;
+		}
+		if((g_glyphRefCount[slot] == 0) && ((victim == LCD_NO_GLYPH) || ((uint16)(g_glyphClock - g_glyphLastUse[slot]) > age)))
+		{
+			victim = slot;
+			age = g_glyphClock - g_glyphLastUse[slot];
+		}
+	}
+	if(victim == LCD_NO_GLYPH)
+	{
+		return LCD_NO_GLYPH;
+	}
+	g_glyphSource[victim] = glyph;
+	g_glyphRefCount[victim] = 1;
+	g_glyphLastUse[victim] = g_glyphClock;
+	LCD_enqueue(LCD_QUEUE_GLYPH | victim);
+	return victim + LCD_GLYPH_CODE_OFFSET;
+}
+
+/*
+ * Description :
+ * Give back a character code got from LCD_acquireGlyph, the glyph stays cached
+ */
+void LCD_releaseGlyph(uint8 code)
+{
+	uint8 slot = code - LCD_GLYPH_CODE_OFFSET;
+
+	if((slot < LCD_NUM_OF_GLYPHS) && (g_glyphRefCount[slot] != 0))
+	{
+		g_glyphRefCount[slot]--;
+	}
+}
+
+/*
+ * Description :
+ * Place a progress bar of width cells at a position and draw it empty
+ */
+void LCD_progressBarInit(LCD_ProgressBarType *bar,uint8 row,uint8 col,uint8 width)
+{
+	bar->row = row;
+	bar->col = col;
+	bar->width = width;
+	bar->partial = 0;
+	bar->glyph = LCD_NO_GLYPH;
+	bar->steps = 0xFF;
+	LCD_progressBarSet(bar,0,1);
+}
+
+/*
+ * Description :
+ * Draw value/max of the bar with LCD_GLYPH_WIDTH steps per cell: full cells, one
+ * partially filled cell (a cached glyph) and empty cells. Nothing changes on the
+ * screen (and no glyph is acquired) while the number of steps stays the same.
+ */
+void LCD_progressBarSet(LCD_ProgressBarType *bar,uint16 value,uint16 max)
+{
+	uint8 steps,cell,full,partial;
+
+	if(max == 0)
+	{
+		return;
+	}
+	if(value > max)
+	{
+		value = max;
+	}
+	steps = (uint8)(((uint32)value * bar->width * LCD_GLYPH_WIDTH) / max);
+	if(steps == bar->steps)
+	{
+		return;
+	}
+	bar->steps = steps;
+	full = steps / LCD_GLYPH_WIDTH;
+	partial = steps - (full * LCD_GLYPH_WIDTH);
+
+	if(partial != bar->partial)
+	{
+		if(bar->glyph != LCD_NO_GLYPH)
+		{
+			LCD_releaseGlyph(bar->glyph);
+			bar->glyph = LCD_NO_GLYPH;
+		}
+		if(partial != 0)
+		{
+			bar->glyph = LCD_acquireGlyph(g_barGlyphs[partial - 1]);
+		}
+		bar->partial = partial;
+	}
+
+	LCD_moveCursor(bar->row,bar->col);
+	for(cell=0;cell<bar->width;cell++)
+	{
+		if(cell < full)
+		{
+			LCD_putCharacter(LCD_SOLID_BLOCK_CODE);
+		}
+		else if((cell == full) && (partial != 0) && (bar->glyph != LCD_NO_GLYPH))
+		{
+			LCD_putCharacter(bar->glyph);
+		}
+		else
+		{
+			LCD_putCharacter(' ');
+		}
+	}
+}
+
+/*
+ * Description :
+ * Give back the glyph held by the bar, the cells stay on the screen until overwritten
+ */
+void LCD_progressBarRelease(LCD_ProgressBarType *bar)
+{
+	if(bar->glyph != LCD_NO_GLYPH)
+	{
+		LCD_releaseGlyph(bar->glyph);
+		bar->glyph = LCD_NO_GLYPH;
+	}
+	bar->partial = 0;
+}
@@ -1,116 +1,248 @@
- /******************************************************************************
- *
- * Module: LCD
- *
- * File Name: lcd.h
- *
- * Description: Header file for the LCD driver
- *
- * Author: Mohamed Tarek
- *
- *******************************************************************************/
-
-#ifndef LCD_H_
-#define LCD_H_
-
-#include "std_types.h"
-
-/*******************************************************************************
- *                                Definitions                                  *
- *******************************************************************************/
-
-/* LCD Data bits mode configuration, its value should be 4 or 8*/
-#define LCD_DATA_BITS_MODE 8
-
-#if((LCD_DATA_BITS_MODE != 4) && (LCD_DATA_BITS_MODE != 8))
-
-#error "Number of Data bits should be equal to 4 or 8"
-
-#endif
-
-#if (LCD_DATA_BITS_MODE == 4)
-
-#ifdef LCD_LAST_PORT_PINS
-#define LCD_FIRST_DATA_PIN_ID         PIN4_ID
-#else
-#define LCD_FIRST_DATA_PIN_ID         PIN0_ID
-#endif
-
-#endif
-
-/* LCD HW Ports and Pins Ids */
-#define LCD_RS_PORT_ID                 PORTB_ID
-#define LCD_RS_PIN_ID                  PIN0_ID
-
-#define LCD_RW_PORT_ID                 PORTB_ID
-#define LCD_RW_PIN_ID                  PIN1_ID
-
-#define LCD_E_PORT_ID                  PORTB_ID
-#define LCD_E_PIN_ID                   PIN2_ID
-
-#define LCD_DATA_PORT_ID               PORTC_ID
-
-/* LCD Commands */
-#define LCD_CLEAR_COMMAND              0x01
-#define LCD_GO_TO_HOME                 0x02
-#define LCD_TWO_LINES_EIGHT_BITS_MODE  0x38
-#define LCD_TWO_LINES_FOUR_BITS_MODE   0x28
-#define LCD_CURSOR_OFF                 0x0C
-#define LCD_CURSOR_ON                  0x0E
-#define LCD_SET_CURSOR_LOCATION        0x80
-
-/*******************************************************************************
- *                      Functions Prototypes                                   *
- *******************************************************************************/
-
-/*
- * Description :
- * Initialize the LCD:
- * 1. Setup the LCD pins directions by use the GPIO driver.
- * 2. Setup the LCD Data Mode 4-bits or 8-bits.
- */
-void LCD_init(void);
-
-/*
- * Description :
- * Send the required command to the screen
- */
-void LCD_sendCommand(uint8 command);
-
-/*
- * Description :
- * Display the required character on the screen
- */
-void LCD_displayCharacter(uint8 data);
-
-/*
- * Description :
- * Display the required string on the screen
- */
-void LCD_displayString(const char *Str);
-
-/*
- * Description :
- * Move the cursor to a specified row and column index on the screen
- */
-void LCD_moveCursor(uint8 row,uint8 col);
-
-/*
- * Description :
- * Display the required string in a specified row and column index on the screen
- */
-void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
-
-/*
- * Description :
- * Display the required decimal value on the screen
- */
-void LCD_intgerToString(int data);
-
-/*
- * Description :
- * Send the clear screen command
- */
-void LCD_clearScreen(void);
-
-#endif /* LCD_H_ */
+ /******************************************************************************
+ *
+ * Module: LCD
+ *
+ * File Name: lcd.h
+ *
+ * Description: Header file for the LCD driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+#ifndef LCD_H_
+#define LCD_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* LCD Data bits mode configuration, its value should be 4 or 8*/
+#define LCD_DATA_BITS_MODE 8
+
+#if((LCD_DATA_BITS_MODE != 4) && (LCD_DATA_BITS_MODE != 8))
+
+#error "Number of Data bits should be equal to 4 or 8"
+
+#endif
+
+#if (LCD_DATA_BITS_MODE == 4)
+
+#ifdef LCD_LAST_PORT_PINS
+#define LCD_FIRST_DATA_PIN_ID         PIN4_ID
+#else
+#define LCD_FIRST_DATA_PIN_ID         PIN0_ID
+#endif
+
+#endif
+
+/*
+ * LCD timing configuration:
+ * 1: read the busy flag on D7 before every transfer, needs the RW pin wired to the MCU
+ * 0: fixed millisecond delays around every transfer (RW may be tied to ground)
+ */
+#define LCD_USE_BUSY_FLAG 1
+
+/* LCD HW Ports and Pins Ids */
+#define LCD_RS_PORT_ID                 PORTB_ID
+#define LCD_RS_PIN_ID                  PIN0_ID
+
+#define LCD_RW_PORT_ID                 PORTB_ID
+#define LCD_RW_PIN_ID                  PIN1_ID
+
+#define LCD_E_PORT_ID                  PORTB_ID
+#define LCD_E_PIN_ID                   PIN2_ID
+
+#define LCD_DATA_PORT_ID               PORTC_ID
+
+/* LCD Commands */
+#define LCD_CLEAR_COMMAND              0x01
+#define LCD_GO_TO_HOME                 0x02
+#define LCD_TWO_LINES_EIGHT_BITS_MODE  0x38
+#define LCD_TWO_LINES_FOUR_BITS_MODE   0x28
+#define LCD_CURSOR_OFF                 0x0C
+#define LCD_CURSOR_ON                  0x0E
+#define LCD_SET_CURSOR_LOCATION        0x80
+
+/* LCD geometry, 2x16, 2x20, 4x16 and 4x20 displays are supported */
+#define LCD_NUM_ROWS                   2
+#define LCD_NUM_COLS                   20
+
+/*
+ * The drawing functions write to a RAM copy of the screen (shadow framebuffer) and
+ * mark the changed cells dirty, only the dirty cells are sent to the LCD.
+ * A clean gap of up to this many cells inside a row is re-written instead of
+ * sending a cursor command (one command costs the same as one character).
+ */
+#define LCD_MAX_REWRITE_GAP            1
+
+/*
+ * The LCD is written in the background by LCD_task, called from a periodic timer
+ * callback. It sends at most LCD_TRANSFERS_PER_TASK transfers (commands or characters)
+ * per call. Without the busy flag the LCD executes one transfer per call.
+ */
+#if (LCD_USE_BUSY_FLAG == 1)
+#define LCD_TRANSFERS_PER_TASK         4
+#else
+#define LCD_TRANSFERS_PER_TASK         1
+#endif
+
+/* Glyphs: 5 pixel columns per cell, LCD_acquireGlyph returns LCD_NO_GLYPH if the CGRAM is full */
+#define LCD_GLYPH_WIDTH                5
+#define LCD_NO_GLYPH                   0xFF
+
+/* Number of queued commands, must be a power of 2 */
+#define LCD_QUEUE_SIZE                 8
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	uint8 row;              /* position of the first cell */
+	uint8 col;
+	uint8 width;            /* number of cells, up to 51 */
+	uint8 steps;            /* filled pixel columns drawn */
+	uint8 partial;          /* filled pixel columns of the partial cell, 0 if none */
+	uint8 glyph;            /* character code of the partial cell glyph or LCD_NO_GLYPH */
+}LCD_ProgressBarType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Initialize the LCD:
+ * 1. Setup the LCD pins directions by use the GPIO driver.
+ * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ */
+void LCD_init(void);
+
+/*
+ * Description :
+ * Queue the required command, it is sent by the LCD task before the dirty cells
+ */
+void LCD_sendCommand(uint8 command);
+
+/*
+ * Description :
+ * Display the required character on the screen at the cursor position
+ */
+void LCD_displayCharacter(uint8 data);
+
+/*
+ * Description :
+ * Display the required string on the screen
+ */
+void LCD_displayString(const char *Str);
+
+/*
+ * Description :
+ * Move the cursor to a specified row and column index on the screen
+ */
+void LCD_moveCursor(uint8 row,uint8 col);
+
+/*
+ * Description :
+ * Display the required string in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Display a string kept in flash (PROGMEM) on the screen
+ */
+void LCD_displayFlashString(const char *Str);
+
+/*
+ * Description :
+ * Display a string kept in flash (PROGMEM) in a specified row and column index on the screen
+ */
+void LCD_displayFlashStringRowColumn(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Display the required decimal value on the screen
+ */
+void LCD_intgerToString(int data);
+
+/*
+ * Description :
+ * Display an unsigned value right aligned in a field of width characters (padded with
+ * '0' or ' ') in a specified row and column index on the screen
+ */
+void LCD_displayNumberRowColumn(uint8 row,uint8 col,uint16 data,uint8 width,char pad);
+
+/*
+ * Description :
+ * Display a countdown in seconds as mm:ss in a specified row and column index on the screen
+ */
+void LCD_displayCountdownRowColumn(uint8 row,uint8 col,uint16 seconds);
+
+/*
+ * Description :
+ * Clear the screen and move the cursor home
+ */
+void LCD_clearScreen(void);
+
+/*
+ * Description :
+ * Send the next few queued commands and dirty cells to the LCD, it never waits for
+ * the LCD more than a few polls. Called every 1 ms from a timer callback.
+ */
+void LCD_task(void);
+
+/*
+ * Description :
+ * Return TRUE if everything written so far is on the LCD.
+ */
+boolean LCD_isIdle(void);
+
+/*
+ * Description :
+ * Set the function called (from the LCD task) once everything written is on the LCD.
+ */
+void LCD_setIdleCallBack(void(*a_ptr)(void));
+
+/*
+ * Description :
+ * Flush barrier: wait until everything written so far is on the LCD.
+ */
+void LCD_flush(void);
+
+/*
+ * Description :
+ * Get a character code (8 to 15) showing a glyph of 8 rows kept in flash, the glyph
+ * is uploaded to the CGRAM (in the background) unless it is already cached there.
+ * Return LCD_NO_GLYPH if all the 8 CGRAM slots are held.
+ */
+uint8 LCD_acquireGlyph(const uint8 *glyph);
+
+/*
+ * Description :
+ * Give back a character code got from LCD_acquireGlyph.
+ */
+void LCD_releaseGlyph(uint8 code);
+
+/*
+ * Description :
+ * Place a progress bar of width cells at a specified row and column and draw it empty.
+ */
+void LCD_progressBarInit(LCD_ProgressBarType *bar,uint8 row,uint8 col,uint8 width);
+
+/*
+ * Description :
+ * Draw value/max of the bar, LCD_GLYPH_WIDTH steps per cell.
+ */
+void LCD_progressBarSet(LCD_ProgressBarType *bar,uint16 value,uint16 max);
+
+/*
+ * Description :
+ * Give back the glyph held by the bar.
+ */
+void LCD_progressBarRelease(LCD_ProgressBarType *bar);
+
+#endif /* LCD_H_ */
@@ -1,230 +1,469 @@
-
-/******************************************************************************
- *
- * Module: HMI ECU supporting functions
- *
- * File Name: HMI_supportingFunctions.c
- *
- * Description: Functions than are implemented in the HMI ECU main function
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-
-#include "HMI_supportingFunctions.h"
-
-/*------------------------------------------------------------------------------
- *                              Global Variables                                *
---------------------------------------------------------------------------------*/
-uint16 g_ticks = 0;
-/*-------------------------------------------------------------------------------
- *                       Functions Definitions                           		 *
---------------------------------------------------------------------------------*/
-/*-------------------------------------------------------------------------------
- * [Function Name]: HMI_mainOptions
- *
- * [Description]:  Function to show the main options that the HMI ECU can display to the user
- * 					1- OPEN THE DOOR
- * 					2- CHANGE PASSWORD
- *
- * [Args]:         Void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void HMI_mainOptions (void)
-{
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0,"+: Open Door");
-	LCD_displayStringRowColumn(1, 0, "-: Change Password");
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Get_password
- *
- * [Description]:  Function to get the password from the user via KEYPAD
- *
- * [Args]:         password: a pointer to uint8
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Get_password (uint8 *password)
-{
-	LCD_moveCursor(1, 0);
-	/*variable used to get the keypad button pressed by user */
-	uint8 key,i;
-
-	for(i=0;i<PASSWORD_LENGTH;i++)
-	{
-		key = KEYPAD_getPressedKey();
-		/*password must be numbers only*/
-		if (key >= 0 && key <= 9) {
-			LCD_displayCharacter('*');
-			password[i]= key;
-		}else
-		{
-			/*in case of pressing not a number button
-			 * i will decrement the i counter to get 5 number password only
-			 */
-			i--;
-		}
-		_delay_ms(KEYPAD_PRESSED_TIME);
-	}
-	/*
-	 * do not exit from the function without pressing a ENTER button
-	 */
-	while(KEYPAD_getPressedKey() != ENTER_ASCII);
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Send_passwordToControlECU
- *
- * [Description]:  Function to send the password to the Control ECU via UART
- *
- * [Args]:         pass: a pointer to uint8
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-
-void Send_passwordToControlECU(uint8 *pass)
-{
-	for (uint8 i=0;i<PASSWORD_LENGTH;i++)
-	{
-		UART_sendByte(pass[i]);
-		_delay_ms(50);
-	}
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Setting_password
- *
- * [Description]:  Function to change the password
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Setting_password (void)
-{
-	uint8 Password_entered[PASSWORD_LENGTH]; /*for initialized password*/
-	uint8 Password_confirmed[PASSWORD_LENGTH]; /*for password confirmation*/
-	uint8 Password_state=PASSWORD_UNMATCH; /*to store password state*/
-
-	while (Password_state==PASSWORD_UNMATCH)
-	{
-		LCD_clearScreen();
-		LCD_displayString("Enter New Pass");
-
-		Get_password(Password_entered);
-		UART_sendByte(READY);
-		while(UART_recieveByte()!=READY);
-		Send_passwordToControlECU(Password_entered);
-		/*To get confirmation from user*/
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 0, "Confirm Password");
-
-		Get_password(Password_confirmed);
-		UART_sendByte(READY);
-		while(UART_recieveByte()!=READY);
-		Send_passwordToControlECU(Password_confirmed);
-		while(UART_recieveByte()!=READY);
-		Password_state=UART_recieveByte();
-		if (Password_state==PASSOWRD_MATCH)
-		{
-			LCD_clearScreen();
-			LCD_displayStringRowColumn(0, 0, "Password Match");
-			LCD_displayStringRowColumn(1, 0, "Password Saved!");
-			_delay_ms(500);
-		}
-		else if (Password_state==PASSWORD_UNMATCH)
-		{
-			LCD_clearScreen();
-			LCD_displayStringRowColumn(0, 0, "Password Un-match");
-			LCD_displayStringRowColumn(1, 0, "Try again!");
-			_delay_ms(500);
-		}
-	}
-	LCD_clearScreen();
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Timer_callBack
- *
- * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Timer_callBack (void)
-{
-	g_ticks++;
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: Door_tasks
- *
- * [Description]:  Function to display door state
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Door_tasks (void)
-{
-	g_ticks=0;
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "Door is opening...");
-	/*
-	 * waiting until the door state changed
-	 */
-	while(g_ticks<DOOR_OPENNING_TIME);
-
-
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "Door is open");
-	while(g_ticks<DOOR_LEFT_OPEN_TIME);
-
-
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "Door is locking.. ");
-	while(g_ticks<DOOR_CLOSING_TIME);
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: unmatchedPasswordMSG
- *
- * [Description]:  Function to display a msg in case of un-matched passwords
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void unmatchedPasswordMSG(void)
-{
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0,0,"Un-matched Password!");
-	LCD_displayStringRowColumn(1, 0, "Try again...");
-	_delay_ms(500);
-}
-/*-------------------------------------------------------------------------------
- * [Function Name]: dangerAlert
- *
- * [Description]:  Function to display a msg in case of un-matched passwords
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void dangerAlert(void)
-{
-	g_ticks=0;
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "DANGER !");
-	LCD_displayStringRowColumn(1,0,"ALERT ON!");
-
-	while(g_ticks < DANGER_TIME ){};
-
-}
-
+
+/******************************************************************************
+ *
+ * Module: HMI ECU supporting functions
+ *
+ * File Name: HMI_supportingFunctions.c
+ *
+ * Description: Functions than are implemented in the HMI ECU main function
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "HMI_supportingFunctions.h"
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+volatile uint16 g_ticks = 0;
+
+/*
+ * User interface strings, kept in flash and read by the LCD driver (LCD_displayFlashString)
+ */
+static const char g_strOpenDoor[] PROGMEM = "+: Open Door";
+static const char g_strChangePassword[] PROGMEM = "-: Change Password";
+static const char g_strEnterPassword[] PROGMEM = "Enter The Password";
+static const char g_strEnterNewPassword[] PROGMEM = "Enter New Pass";
+static const char g_strConfirmPassword[] PROGMEM = "Confirm Password";
+static const char g_strPasswordMatch[] PROGMEM = "Password Match";
+static const char g_strPasswordSaved[] PROGMEM = "Password Saved!";
+static const char g_strPasswordUnmatch[] PROGMEM = "Password Un-match";
+static const char g_strTryAgain[] PROGMEM = "Try again!";
+static const char g_strDoorOpening[] PROGMEM = "Door is opening...";
+static const char g_strDoorOpen[] PROGMEM = "Door is open";
+static const char g_strDoorLocking[] PROGMEM = "Door is locking.. ";
+static const char g_strDoorJammed[] PROGMEM = "Door jammed!";
+static const char g_strWrongPassword[] PROGMEM = "Un-matched Password!";
+static const char g_strTryAgainLater[] PROGMEM = "Try again...";
+static const char g_strDanger[] PROGMEM = "DANGER !";
+static const char g_strAlertOn[] PROGMEM = "ALERT ON!";
+static const char g_strAuditRecords[] PROGMEM = "Audit records:";
+static const char g_strAuditOpen[] PROGMEM = "Open:";
+static const char g_strAuditWrong[] PROGMEM = " Wrong:";
+static const char g_strStorageFault[] PROGMEM = "EEPROM fault!";
+static const char g_strRetrying[] PROGMEM = "Retrying...";
+
+/* String table: flash address of every string, in UI_StringIdType order */
+static const char * const g_uiStrings[UI_NUM_OF_STRINGS] PROGMEM =
+{
+	NULL_PTR,g_strOpenDoor,g_strChangePassword,g_strEnterPassword,
+	g_strEnterNewPassword,g_strConfirmPassword,g_strPasswordMatch,
+	g_strPasswordSaved,g_strPasswordUnmatch,g_strTryAgain,g_strDoorOpening,
+	g_strDoorOpen,g_strDoorLocking,g_strDoorJammed,g_strWrongPassword,g_strTryAgainLater,
+	g_strDanger,g_strAlertOn,g_strAuditRecords,g_strAuditOpen,g_strAuditWrong,
+	g_strStorageFault,g_strRetrying
+};
+
+/* Screen table, in UI_ScreenIdType order */
+static const UI_ScreenType g_uiScreens[UI_NUM_OF_SCREENS] PROGMEM =
+{
+	{{UI_STR_OPEN_DOOR,UI_STR_CHANGE_PASSWORD}},		/* UI_SCREEN_MAIN_OPTIONS */
+	{{UI_STR_ENTER_PASSWORD,UI_STR_NONE}},				/* UI_SCREEN_ENTER_PASSWORD */
+	{{UI_STR_ENTER_NEW_PASSWORD,UI_STR_NONE}},			/* UI_SCREEN_ENTER_NEW_PASSWORD */
+	{{UI_STR_CONFIRM_PASSWORD,UI_STR_NONE}},			/* UI_SCREEN_CONFIRM_PASSWORD */
+	{{UI_STR_PASSWORD_MATCH,UI_STR_PASSWORD_SAVED}},	/* UI_SCREEN_PASSWORD_SAVED */
+	{{UI_STR_PASSWORD_UNMATCH,UI_STR_TRY_AGAIN}},		/* UI_SCREEN_PASSWORD_UNMATCH */
+	{{UI_STR_DOOR_OPENING,UI_STR_NONE}},				/* UI_SCREEN_DOOR_OPENING */
+	{{UI_STR_DOOR_OPEN,UI_STR_NONE}},					/* UI_SCREEN_DOOR_OPEN */
+	{{UI_STR_DOOR_LOCKING,UI_STR_NONE}},				/* UI_SCREEN_DOOR_LOCKING */
+	{{UI_STR_DOOR_JAMMED,UI_STR_NONE}},					/* UI_SCREEN_DOOR_JAMMED */
+	{{UI_STR_WRONG_PASSWORD,UI_STR_TRY_AGAIN_LATER}},	/* UI_SCREEN_WRONG_PASSWORD */
+	{{UI_STR_DANGER,UI_STR_ALERT_ON}},					/* UI_SCREEN_DANGER */
+	{{UI_STR_STORAGE_FAULT,UI_STR_RETRYING}}			/* UI_SCREEN_STORAGE_FAULT */
+};
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: HMI_mainOptions
+ *
+ * [Description]:  Function to show the main options that the HMI ECU can display to the user
+ * 					1- OPEN THE DOOR
+ * 					2- CHANGE PASSWORD
+ *
+ * [Args]:         Void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void HMI_mainOptions (void)
+{
+	Display_screen(UI_SCREEN_MAIN_OPTIONS);
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Get_password
+ *
+ * [Description]:  Function to get the password from the user via KEYPAD
+ *
+ * [Args]:         password: a pointer to uint8
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Get_password (uint8 *password)
+{
+	LCD_moveCursor(1, 0);
+	/*variable used to get the keypad button pressed by user */
+	uint8 key,i;
+
+	for(i=0;i<PASSWORD_LENGTH;i++)
+	{
+		key = KEYPAD_getPressedKey();
+		/*password must be numbers only*/
+		if (key >= 0 && key <= 9) {
+			LCD_displayCharacter('*');
+			password[i]= key;
+		}else
+		{
+			/*in case of pressing not a number button
+			 * i will decrement the i counter to get 5 number password only
+			 */
+			i--;
+		}
+	}
+	/*
+	 * do not exit from the function without pressing a ENTER button
+	 */
+	while(KEYPAD_getPressedKey() != ENTER_ASCII);
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Send_passwordToControlECU
+ *
+ * [Description]:  Function to send the password to the Control ECU via UART
+ *
+ * [Args]:         pass: a pointer to uint8
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+
+void Send_passwordToControlECU(uint8 *pass)
+{
+	for (uint8 i=0;i<PASSWORD_LENGTH;i++)
+	{
+		UART_sendByte(pass[i]);
+		_delay_ms(50);
+	}
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Setting_password
+ *
+ * [Description]:  Function to change the password
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Setting_password (void)
+{
+	uint8 Password_entered[PASSWORD_LENGTH]; /*for initialized password*/
+	uint8 Password_confirmed[PASSWORD_LENGTH]; /*for password confirmation*/
+	uint8 Password_state=PASSWORD_UNMATCH; /*to store password state*/
+
+	while (Password_state==PASSWORD_UNMATCH)
+	{
+		Display_screen(UI_SCREEN_ENTER_NEW_PASSWORD);
+
+		Get_password(Password_entered);
+		UART_sendByte(READY);
+		while(UART_recieveByte()!=READY);
+		Send_passwordToControlECU(Password_entered);
+		/*To get confirmation from user*/
+		Display_screen(UI_SCREEN_CONFIRM_PASSWORD);
+
+		Get_password(Password_confirmed);
+		UART_sendByte(READY);
+		while(UART_recieveByte()!=READY);
+		Send_passwordToControlECU(Password_confirmed);
+		while(UART_recieveByte()!=READY);
+		Password_state=UART_recieveByte();
+		if (Password_state==PASSOWRD_MATCH)
+		{
+			Display_screen(UI_SCREEN_PASSWORD_SAVED);
+			_delay_ms(500);
+		}
+		else if (Password_state==PASSWORD_UNMATCH)
+		{
+			Display_screen(UI_SCREEN_PASSWORD_UNMATCH);
+			_delay_ms(500);
+		}
+	}
+	LCD_clearScreen();
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Timer_callBack
+ *
+ * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Timer_callBack (void)
+{
+	g_ticks++;
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Get_ticks
+ *
+ * [Description]:  Function that reads the Timer1 ticks since the last Reset_ticks (shared
+ * 					with the Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint16 data: the ticks since the last reset
+ *
+----------------------------------------------------------------------------------*/
+uint16 Get_ticks (void)
+{
+	uint16 ticks;
+	uint8 sreg = SREG;
+
+	cli();
+	ticks = g_ticks;
+	SREG = sreg;
+
+	return ticks;
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Reset_ticks
+ *
+ * [Description]:  Function that starts counting the Timer1 ticks from zero (shared with the
+ * 					Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Reset_ticks (void)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	g_ticks = 0;
+	SREG = sreg;
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FastTimer_callBack
+ *
+ * [Description]:  Function to be used by the 1 ms Timer0 tick, it runs the background
+ * 					LCD writes every tick and the keypad scan every KEYPAD_SCAN_PERIOD_MS
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void FastTimer_callBack (void)
+{
+	static uint8 scan_ms = 0;
+
+	LCD_task();
+
+	if (++scan_ms >= KEYPAD_SCAN_PERIOD_MS)
+	{
+		scan_ms = 0;
+		KEYPAD_scanTask();
+	}
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Door_tasks
+ *
+ * [Description]:  Function to display door state and position as reported by the Control ECU
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Door_tasks (void)
+{
+	LCD_ProgressBarType bar;
+	uint8 report;
+	/* 0: opening, 1: open (or jammed while opening), 2: closing */
+	uint8 phase = 0;
+	boolean finished = FALSE;
+
+	Display_screen(UI_SCREEN_DOOR_OPENING);
+	LCD_progressBarInit(&bar, 1, 0, DOOR_PROGRESS_BAR_WIDTH);
+	/*
+	 * the Control ECU stops the door at its end stops, the bar follows the reported position:
+	 * it fills while the door opens and empties while the door closes.
+	 * The door is closed after a jam while opening too, so every movement ends with
+	 * DOOR_REACHED_CLOSED or DOOR_JAMMED of the closing.
+	 */
+	do
+	{
+		report = UART_recieveByte();
+		if (report == DOOR_PROGRESS_REPORT)
+		{
+			if (phase == 1)
+			{
+				phase = 2;
+				Display_screen(UI_SCREEN_DOOR_LOCKING);
+				LCD_progressBarInit(&bar, 1, 0, DOOR_PROGRESS_BAR_WIDTH);
+			}
+			LCD_progressBarSet(&bar, UART_recieveByte(), 100);
+		}
+		else if ((phase == 0) && ((report == DOOR_REACHED_OPEN) || (report == DOOR_JAMMED)))
+		{
+			phase = 1;
+			LCD_progressBarRelease(&bar);
+			Display_screen((report == DOOR_REACHED_OPEN) ? UI_SCREEN_DOOR_OPEN : UI_SCREEN_DOOR_JAMMED);
+		}
+		else if ((report == DOOR_REACHED_CLOSED) || (report == DOOR_JAMMED))
+		{
+			finished = TRUE;
+		}
+	}while (finished == FALSE);
+	LCD_progressBarRelease(&bar);
+
+	/* the door could not be locked: keep the message on the screen for a while */
+	if (report == DOOR_JAMMED)
+	{
+		Reset_ticks();
+		Display_screen(UI_SCREEN_DOOR_JAMMED);
+		while(Get_ticks()<DOOR_JAMMED_MSG_TIME);
+	}
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: unmatchedPasswordMSG
+ *
+ * [Description]:  Function to display a msg and the remaining lockout time in case of
+ * 					un-matched passwords
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void unmatchedPasswordMSG(void)
+{
+	Display_screen(UI_SCREEN_WRONG_PASSWORD);
+	_delay_ms(500);
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: dangerAlert
+ *
+ * [Description]:  Function to display the lockout after a Danger reply of the Control ECU:
+ * 					receive the remaining lockout time and count it down
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void dangerAlert(void)
+{
+	uint16 remaining;
+	uint8 sreg;
+
+	remaining = (uint16)UART_recieveByte() << 8;
+	remaining |= UART_recieveByte();
+
+	Reset_ticks();
+	Display_screen(UI_SCREEN_DANGER);
+	LCD_displayCountdownRowColumn(1, DANGER_COUNTDOWN_COL, remaining);
+
+	while(remaining != 0)
+	{
+		if (Get_ticks() >= TICKS_PER_SECOND)
+		{
+			/* g_ticks is shared with the Timer1 call back */
+			sreg = SREG;
+			cli();
+			g_ticks -= TICKS_PER_SECOND;
+			SREG = sreg;
+
+			remaining--;
+			LCD_displayCountdownRowColumn(1, DANGER_COUNTDOWN_COL, remaining);
+		}
+	}
+
+	/* the keys pressed during the alert are not an input for the next screen */
+	KEYPAD_flush();
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Show_auditSummary
+ *
+ * [Description]:  Function to receive the audit log the Control ECU sends after a matched
+ * 					password (maintenance chord) and display the number of records,
+ * 					door openings and wrong passwords
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Show_auditSummary(void)
+{
+	uint8 count, i, j, byte;
+	uint8 unlocks = 0, wrong = 0;
+
+	count = UART_recieveByte();
+	for (i = 0; i < count; i++)
+	{
+		for (j = 0; j < AUDIT_RECORD_SIZE; j++)
+		{
+			byte = UART_recieveByte();
+			if (j == AUDIT_RECORD_EVENT_OFFSET)
+			{
+				if (byte == AUDIT_EVENT_UNLOCK)
+					unlocks++;
+				else if (byte == AUDIT_EVENT_WRONG_PASSWORD)
+					wrong++;
+			}
+		}
+	}
+	LCD_clearScreen();
+	Display_string(0, 0, UI_STR_AUDIT_RECORDS);
+	LCD_intgerToString(count);
+	Display_string(1, 0, UI_STR_AUDIT_OPEN);
+	LCD_intgerToString(unlocks);
+	Display_string(1, 7, UI_STR_AUDIT_WRONG);
+	LCD_intgerToString(wrong);
+	_delay_ms(2000);
+	LCD_clearScreen();
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Display_string
+ *
+ * [Description]:  Function to display a user interface string (from flash) at a position
+ *
+ * [Args]:         row, col: the LCD position
+ * 				   id: the string ID
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Display_string(uint8 row, uint8 col, UI_StringIdType id)
+{
+	if ((id != UI_STR_NONE) && (id < UI_NUM_OF_STRINGS))
+	{
+		LCD_displayFlashStringRowColumn(row, col, (const char *)pgm_read_ptr(&g_uiStrings[id]));
+	}
+}
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Display_screen
+ *
+ * [Description]:  Function to clear the LCD and display a screen of the screen table
+ *
+ * [Args]:         id: the screen ID
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Display_screen(UI_ScreenIdType id)
+{
+	uint8 row;
+
+	LCD_clearScreen();
+	for (row = 0; row < 2; row++)
+	{
+		Display_string(row, 0, pgm_read_byte(&g_uiScreens[id].rows[row]));
+	}
+}
@@ -1,147 +1,282 @@
-/******************************************************************************
- *
- * Module: HMI ECU supporting functions
- *
- * File Name: HMI_supportingFunctions.c
- *
- * Description: Functions than are implemented in the HMI ECU main function
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-#ifndef HMI_SUPPORTINGFUNCTIONS_H_
-#define HMI_SUPPORTINGFUNCTIONS_H_
-
-#include "keypad.h"
-#include "util/delay.h"
-#include "uart.h"
-#include "avr/io.h"
-#include "timer.h"
-#include "std_types.h"
-#include "lcd.h"
-#include <avr/interrupt.h>
-/*------------------------------------------------------------------------------
- *                              Definitions                                 	*
---------------------------------------------------------------------------------*/
-/*Password related definitions*/
-#define PASSWORD_LENGTH  					 5
-#define PASSOWRD_MATCH   					 1
-#define PASSWORD_UNMATCH  					 0
-#define ENTER_ASCII						     13
-#define NUMBER_OF_WRONG_PASSWORD_ATTEMPTS  	 3
-/*To communicate with Control ECU*/
-#define Opening_Door_Action 				0x88
-#define Changing_Password_Action 			0x44
-#define READY 								0x10
-#define Danger 								0x33
-/*Door options*/
-#define OPEN_DOOR_OPTION					'+'
-#define CHANGE_PASSWORD_OPTION				'-'
-
-/*Timing*/
-#define DOOR_OPENNING_TIME				  1788 //15sec
-#define DOOR_CLOSING_TIME				  1788 //15sec
-#define DOOR_LEFT_OPEN_TIME	 			  357 //3sec
-#define KEYPAD_PRESSED_TIME 			  500
-#define DANGER_TIME						 7152 //60sec
-/*------------------------------------------------------------------------------
- *                              Global Variables                                *
---------------------------------------------------------------------------------*/
-extern uint16 g_ticks;
-/*-------------------------------------------------------------------------*/
-/*--------------------------------------------------------------------------
- *                       Functions Prototypes                               *
-----------------------------------------------------------------------------*/
-/*---------------------------------------------------------------------------
- * [Function Name]: HMI_mainOptions
- *
- * [Description]:  Function to show the main options that the HMI ECU can display to the user
- * 					1- OPEN THE DOOR
- * 					2- CHANGE PASSWORD
- *
- * [Args]:         Void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void HMI_mainOptions (void);
-
-/*-------------------------------------------------------------------------------
- * [Function Name]: Get_password
- *
- * [Description]:  Function to get the password from the user via KEYPAD
- *
- * [Args]:         password: a pointer to uint8
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Get_password (uint8 *password);
-/*-------------------------------------------------------------------------------
- * [Function Name]: Send_passwordToControlECU
- *
- * [Description]:  Function to send the password to the Control ECU via UART
- *
- * [Args]:         pass: a pointer to uint8
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-
-void Send_passwordToControlECU(uint8 *pass);
-/*-------------------------------------------------------------------------------
- * [Function Name]: Setting_password
- *
- * [Description]:  Function to change the password
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Setting_password (void);
-/*-------------------------------------------------------------------------------
- * [Function Name]: Timer_callBack
- *
- * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Timer_callBack (void);
-/*-------------------------------------------------------------------------------
- * [Function Name]: Door_tasks
- *
- * [Description]:  Function to display door state
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void Door_tasks (void);
-/*-------------------------------------------------------------------------------
- * [Function Name]: unmatchedPasswordMSG
- *
- * [Description]:  Function to display a msg in case of un-matched passwords
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void unmatchedPasswordMSG(void);
-/*-------------------------------------------------------------------------------
- * [Function Name]: dangerAlert
- *
- * [Description]:  Function to display a msg in case of un-matched passwords
- *
- * [Args]:         void
- *
- * [Returns]:      Void
- *
-----------------------------------------------------------------------------------*/
-void dangerAlert(void);
-#endif /* HMI_SUPPORTINGFUNCTIONS_H_ */
+/******************************************************************************
+ *
+ * Module: HMI ECU supporting functions
+ *
+ * File Name: HMI_supportingFunctions.c
+ *
+ * Description: Functions than are implemented in the HMI ECU main function
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+#ifndef HMI_SUPPORTINGFUNCTIONS_H_
+#define HMI_SUPPORTINGFUNCTIONS_H_
+
+#include "keypad.h"
+#include "util/delay.h"
+#include "uart.h"
+#include "avr/io.h"
+#include "timer.h"
+#include "std_types.h"
+#include "lcd.h"
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+/*------------------------------------------------------------------------------
+ *                              Definitions                                 	*
+--------------------------------------------------------------------------------*/
+/*Password related definitions*/
+#define PASSWORD_LENGTH  					 5
+#define PASSOWRD_MATCH   					 1
+#define PASSWORD_UNMATCH  					 0
+#define ENTER_ASCII						     13
+#define NUMBER_OF_WRONG_PASSWORD_ATTEMPTS  	 3
+/*To communicate with Control ECU*/
+#define Opening_Door_Action 				0x88
+#define Changing_Password_Action 			0x44
+#define Audit_Summary_Action				0x22
+#define READY 								0x10
+/*Lockout: Danger is followed by the remaining lockout seconds (high byte first)*/
+#define Danger 								0x33
+/*Boot handshake: ask the Control ECU whether a password is already saved*/
+#define PASSWORD_STATUS_REQUEST				0x55
+#define PASSWORD_SAVED						0x66
+#define PASSWORD_NOT_SAVED					0x77
+/*the EEPROM of the Control ECU does not answer: show the fault and ask again*/
+#define STORAGE_FAULT						0x78
+/*Maintenance: after Audit_Summary_Action the Control ECU sends its access audit log
+  (count byte then 8 bytes records)*/
+#define AUDIT_RECORD_SIZE					8
+#define AUDIT_RECORD_EVENT_OFFSET			1
+#define AUDIT_EVENT_UNLOCK					1
+#define AUDIT_EVENT_WRONG_PASSWORD			2
+/*Door movement reports of the Control ECU, a progress report is followed by the open percentage*/
+#define DOOR_PROGRESS_REPORT				0x9A
+#define DOOR_REACHED_OPEN					0x9B
+#define DOOR_REACHED_CLOSED					0x9C
+#define DOOR_JAMMED							0x9D
+/*Door options*/
+#define OPEN_DOOR_OPTION					'+'
+#define CHANGE_PASSWORD_OPTION				'-'
+#define AUDIT_SUMMARY_OPTION				'*'
+
+/*Timing*/
+#define DOOR_JAMMED_MSG_TIME			  SECONDS_TO_TICKS(3)
+#define STORAGE_FAULT_RETRY_MS			  1000
+/*Remaining lockout time (mm:ss) at the end of the second row of the danger screen*/
+#define DANGER_COUNTDOWN_COL			  15
+/*Door progress bar on the second row, 5 steps per cell*/
+#define DOOR_PROGRESS_BAR_WIDTH			  16
+/*------------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+--------------------------------------------------------------------------------*/
+/*
+ * IDs of the user interface strings, the strings themselves are kept in flash
+ */
+typedef enum
+{
+	UI_STR_NONE,UI_STR_OPEN_DOOR,UI_STR_CHANGE_PASSWORD,UI_STR_ENTER_PASSWORD,
+	UI_STR_ENTER_NEW_PASSWORD,UI_STR_CONFIRM_PASSWORD,UI_STR_PASSWORD_MATCH,
+	UI_STR_PASSWORD_SAVED,UI_STR_PASSWORD_UNMATCH,UI_STR_TRY_AGAIN,UI_STR_DOOR_OPENING,
+	UI_STR_DOOR_OPEN,UI_STR_DOOR_LOCKING,UI_STR_DOOR_JAMMED,UI_STR_WRONG_PASSWORD,UI_STR_TRY_AGAIN_LATER,
+	UI_STR_DANGER,UI_STR_ALERT_ON,UI_STR_AUDIT_RECORDS,UI_STR_AUDIT_OPEN,UI_STR_AUDIT_WRONG,
+	UI_STR_STORAGE_FAULT,UI_STR_RETRYING,UI_NUM_OF_STRINGS
+}UI_StringIdType;
+
+/*
+ * IDs of the full screens (one string per row)
+ */
+typedef enum
+{
+	UI_SCREEN_MAIN_OPTIONS,UI_SCREEN_ENTER_PASSWORD,UI_SCREEN_ENTER_NEW_PASSWORD,
+	UI_SCREEN_CONFIRM_PASSWORD,UI_SCREEN_PASSWORD_SAVED,UI_SCREEN_PASSWORD_UNMATCH,
+	UI_SCREEN_DOOR_OPENING,UI_SCREEN_DOOR_OPEN,UI_SCREEN_DOOR_LOCKING,UI_SCREEN_DOOR_JAMMED,
+	UI_SCREEN_WRONG_PASSWORD,UI_SCREEN_DANGER,UI_SCREEN_STORAGE_FAULT,UI_NUM_OF_SCREENS
+}UI_ScreenIdType;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: UI_ScreenType
+ *
+ * [Description]: A screen of the screen table (kept in flash)
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * rows: string ID of every LCD row, UI_STR_NONE leaves the row blank
+	 */
+			uint8	rows[2];
+}UI_ScreenType;
+
+/*------------------------------------------------------------------------------
+ *                              Global Variables                                *
+--------------------------------------------------------------------------------*/
+extern volatile uint16 g_ticks;
+/*-------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------
+ *                       Functions Prototypes                               *
+----------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------
+ * [Function Name]: HMI_mainOptions
+ *
+ * [Description]:  Function to show the main options that the HMI ECU can display to the user
+ * 					1- OPEN THE DOOR
+ * 					2- CHANGE PASSWORD
+ *
+ * [Args]:         Void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void HMI_mainOptions (void);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Get_password
+ *
+ * [Description]:  Function to get the password from the user via KEYPAD
+ *
+ * [Args]:         password: a pointer to uint8
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Get_password (uint8 *password);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Send_passwordToControlECU
+ *
+ * [Description]:  Function to send the password to the Control ECU via UART
+ *
+ * [Args]:         pass: a pointer to uint8
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+
+void Send_passwordToControlECU(uint8 *pass);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Setting_password
+ *
+ * [Description]:  Function to change the password
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Setting_password (void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Timer_callBack
+ *
+ * [Description]:  Function to be used by the Timer driver by incrementing the g_ticks
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Timer_callBack (void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Get_ticks
+ *
+ * [Description]:  Function that reads the Timer1 ticks since the last Reset_ticks (shared
+ * 					with the Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      uint16 data: the ticks since the last reset
+ *
+----------------------------------------------------------------------------------*/
+uint16 Get_ticks (void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Reset_ticks
+ *
+ * [Description]:  Function that starts counting the Timer1 ticks from zero (shared with the
+ * 					Timer1 call back)
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Reset_ticks (void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FastTimer_callBack
+ *
+ * [Description]:  Function to be used by the 1 ms Timer0 tick, it runs the background
+ * 					LCD writes every tick and the keypad scan every KEYPAD_SCAN_PERIOD_MS
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void FastTimer_callBack (void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Door_tasks
+ *
+ * [Description]:  Function to display door state and position as reported by the Control ECU
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Door_tasks (void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: unmatchedPasswordMSG
+ *
+ * [Description]:  Function to display a msg in case of un-matched passwords
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void unmatchedPasswordMSG(void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: dangerAlert
+ *
+ * [Description]:  Function to display the lockout after a Danger reply of the Control ECU
+ * 					and count down the remaining lockout time it sends
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void dangerAlert(void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Show_auditSummary
+ *
+ * [Description]:  Function to receive the audit log the Control ECU sends after a matched
+ * 					password (maintenance chord) and display the number of records,
+ * 					door openings and wrong passwords
+ *
+ * [Args]:         void
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Show_auditSummary(void);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Display_string
+ *
+ * [Description]:  Function to display a user interface string (from flash) at a position
+ *
+ * [Args]:         row, col: the LCD position
+ * 				   id: the string ID
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Display_string(uint8 row, uint8 col, UI_StringIdType id);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Display_screen
+ *
+ * [Description]:  Function to clear the LCD and display a screen of the screen table
+ *
+ * [Args]:         id: the screen ID
+ *
+ * [Returns]:      Void
+ *
+----------------------------------------------------------------------------------*/
+void Display_screen(UI_ScreenIdType id);
+#endif /* HMI_SUPPORTINGFUNCTIONS_H_ */
@@ -0,0 +1,159 @@
+/******************************************************************************
+ *
+ * Module: Number format
+ *
+ * File Name: num_format.c
+ *
+ * Description: Source file for the fixed-width decimal formatting used by the LCD
+ * 				and the UART diagnostics (no itoa, no division)
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#include "num_format.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Definitions                           		 *
+--------------------------------------------------------------------------------*/
+/*
+ * The ATmega16 has no divide instruction: itoa calls the 16-bit division routine
+ * (~200 cycles) once per digit. A digit is found here by subtracting its power of ten
+ * at most 9 times (a few cycles each), one call per digit with a constant power.
+ */
+static char FORMAT_digit(uint16 *value, uint16 power)
+{
+	char digit = '0';
+
+	while (*value >= power)
+	{
+		*value -= power;
+		digit++;
+	}
+	return digit;
+}
+
+/*
+ * Common part of the signed and unsigned formatting, sign is 0 for a positive value.
+ */
+static uint8 FORMAT_field(char *buffer, uint16 value, uint8 width, char pad, char sign)
+{
+	char digits[FORMAT_MAX_DIGITS];
+	uint8 first, length, i;
+
+	digits[0] = FORMAT_digit(&value, 10000);
+	digits[1] = FORMAT_digit(&value, 1000);
+	digits[2] = FORMAT_digit(&value, 100);
+	digits[3] = FORMAT_digit(&value, 10);
+	digits[4] = '0' + (char)value;
+
+	/* skip the leading zeros, the last digit is always written */
+	first = 0;
+	while ((first < FORMAT_MAX_DIGITS - 1) && (digits[first] == '0'))
+	{
+		first++;
+	}
+
+	length = FORMAT_MAX_DIGITS - first + (sign ? 1 : 0);
+	i = 0;
+	if (sign && (pad == FORMAT_PAD_ZERO))
+	{
+		buffer[i++] = sign;
+		sign = 0;
+	}
+	for (; length < width; width--)
+	{
+		buffer[i++] = pad;
+	}
+	if (sign)
+	{
+		buffer[i++] = sign;
+	}
+	for (; first < FORMAT_MAX_DIGITS; first++)
+	{
+		buffer[i++] = digits[first];
+	}
+	buffer[i] = '\0';
+	return i;
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FORMAT_unsigned
+ *
+ * [Description]:  Function to write an unsigned value in decimal, right aligned in a field
+ * 					of at least width characters, followed by a null
+ *
+ * [Args]:        buffer: a pointer to the char buffer to be filled (FORMAT_BUFFER_SIZE bytes,
+ * 						  or width + 1 for a wider field)
+ * 				  value: the value to be written
+ * 				  width: minimum field width, a value with more digits is never truncated
+ * 				  pad: FORMAT_PAD_ZERO or FORMAT_PAD_SPACE
+ *
+ * [Returns]:      number of written characters (without the null)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 FORMAT_unsigned(char *buffer, uint16 value, uint8 width, char pad)
+{
+	return FORMAT_field(buffer, value, width, pad, 0);
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FORMAT_signed
+ *
+ * [Description]:  Function to write a signed value in decimal, right aligned in a field
+ * 					of at least width characters, followed by a null. The sign comes before
+ * 					the zero padding ("-007") and after the space padding ("  -7").
+ *
+ * [Args]:        buffer: a pointer to the char buffer to be filled (FORMAT_BUFFER_SIZE bytes,
+ * 						  or width + 1 for a wider field)
+ * 				  value: the value to be written
+ * 				  width: minimum field width (including the sign)
+ * 				  pad: FORMAT_PAD_ZERO or FORMAT_PAD_SPACE
+ *
+ * [Returns]:      number of written characters (without the null)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 FORMAT_signed(char *buffer, sint16 value, uint8 width, char pad)
+{
+	if (value < 0)
+	{
+		/* the magnitude of -32768 still fits in 16 bits when negated as unsigned */
+		return FORMAT_field(buffer, (uint16)0 - (uint16)value, width, pad, '-');
+	}
+	return FORMAT_field(buffer, (uint16)value, width, pad, 0);
+}
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FORMAT_mmss
+ *
+ * [Description]:  Function to write a countdown in seconds as "mm:ss" followed by a null
+ *
+ * [Args]:        buffer: a pointer to the char buffer to be filled (FORMAT_BUFFER_SIZE bytes)
+ * 				  seconds: the time to be written
+ *
+ * [Returns]:      number of written characters (FORMAT_MMSS_LENGTH below 100 minutes)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 FORMAT_mmss(char *buffer, uint16 seconds)
+{
+	uint16 minutes = 0;
+	uint8 length;
+
+	/* tens of minutes first: at most 109 + 9 subtractions for the largest value */
+	while (seconds >= 600)
+	{
+		seconds -= 600;
+		minutes += 10;
+	}
+	while (seconds >= 60)
+	{
+		seconds -= 60;
+		minutes++;
+	}
+	length = FORMAT_unsigned(buffer, minutes, 2, FORMAT_PAD_ZERO);
+	buffer[length++] = ':';
+	buffer[length++] = FORMAT_digit(&seconds, 10);
+	buffer[length++] = '0' + (char)seconds;
+	buffer[length] = '\0';
+	return length;
+}
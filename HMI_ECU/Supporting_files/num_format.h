@@ -0,0 +1,88 @@
+/******************************************************************************
+ *
+ * Module: Number format
+ *
+ * File Name: num_format.h
+ *
+ * Description: Header file for the fixed-width decimal formatting used by the LCD
+ * 				and the UART diagnostics (no itoa, no division)
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef NUM_FORMAT_H_
+#define NUM_FORMAT_H_
+
+#include "std_types.h"
+
+/*-------------------------------------------------------------------------------
+ *                       Definitions                         					 *
+--------------------------------------------------------------------------------*/
+#define FORMAT_PAD_ZERO					'0'
+#define FORMAT_PAD_SPACE				' '
+
+/* digits of the largest uint16 value (65535) */
+#define FORMAT_MAX_DIGITS				5
+
+/* "mm:ss", longer if the minutes need more than two digits */
+#define FORMAT_MMSS_LENGTH				5
+
+/*
+ * Buffer size that fits the longest output: a countdown of 65535 s ("1092:15") and the
+ * null. A number in a field wider than 7 characters needs width + 1 bytes.
+ */
+#define FORMAT_BUFFER_SIZE				8
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                          			 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FORMAT_unsigned
+ *
+ * [Description]:  Function to write an unsigned value in decimal, right aligned in a field
+ * 					of at least width characters, followed by a null
+ *
+ * [Args]:        buffer: a pointer to the char buffer to be filled (FORMAT_BUFFER_SIZE bytes,
+ * 						  or width + 1 for a wider field)
+ * 				  value: the value to be written
+ * 				  width: minimum field width, a value with more digits is never truncated
+ * 				  pad: FORMAT_PAD_ZERO or FORMAT_PAD_SPACE
+ *
+ * [Returns]:      number of written characters (without the null)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 FORMAT_unsigned(char *buffer, uint16 value, uint8 width, char pad);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FORMAT_signed
+ *
+ * [Description]:  Function to write a signed value in decimal, right aligned in a field
+ * 					of at least width characters, followed by a null. The sign comes before
+ * 					the zero padding ("-007") and after the space padding ("  -7").
+ *
+ * [Args]:        buffer: a pointer to the char buffer to be filled (FORMAT_BUFFER_SIZE bytes,
+ * 						  or width + 1 for a wider field)
+ * 				  value: the value to be written
+ * 				  width: minimum field width (including the sign)
+ * 				  pad: FORMAT_PAD_ZERO or FORMAT_PAD_SPACE
+ *
+ * [Returns]:      number of written characters (without the null)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 FORMAT_signed(char *buffer, sint16 value, uint8 width, char pad);
+
+/*-------------------------------------------------------------------------------
+ * [Function Name]: FORMAT_mmss
+ *
+ * [Description]:  Function to write a countdown in seconds as "mm:ss" followed by a null
+ *
+ * [Args]:        buffer: a pointer to the char buffer to be filled (FORMAT_BUFFER_SIZE bytes)
+ * 				  seconds: the time to be written
+ *
+ * [Returns]:      number of written characters (FORMAT_MMSS_LENGTH below 100 minutes)
+ *
+ ----------------------------------------------------------------------------------*/
+uint8 FORMAT_mmss(char *buffer, uint16 seconds);
+
+#endif /* NUM_FORMAT_H_ */
@@ -0,0 +1,213 @@
+ /******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: gpio.h
+ *
+ * Description: Header file for the AVR GPIO driver
+ *
+ * Author: Mohamed Tarek
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_H_
+#define GPIO_H_
+
+#include "std_types.h"
+#include "common_macros.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define NUM_OF_PORTS           4
+#define NUM_OF_PINS_PER_PORT   8
+
+#define PORTA_ID               0
+#define PORTB_ID               1
+#define PORTC_ID               2
+#define PORTD_ID               3
+
+#define PIN0_ID                0
+#define PIN1_ID                1
+#define PIN2_ID                2
+#define PIN3_ID                3
+#define PIN4_ID                4
+#define PIN5_ID                5
+#define PIN6_ID                6
+#define PIN7_ID                7
+
+/*
+ * Static pin API: the port and pin numbers are compile-time constants (the IDs above or
+ * macros defined as them), so every access compiles to one instruction (SBI/CBI, SBIS/SBIC
+ * in a condition, OUT/IN for a whole port) instead of a call with a port switch and a
+ * range check. An invalid port ID does not compile. The functions below stay for the
+ * port and pin numbers known only at run time.
+ */
+#define GPIO_PORT_REG(port_num)        GPIO_PASTE(GPIO_PORT_,port_num)
+#define GPIO_DDR_REG(port_num)         GPIO_PASTE(GPIO_DDR_,port_num)
+#define GPIO_PIN_REG(port_num)         GPIO_PASTE(GPIO_PIN_,port_num)
+#define GPIO_PASTE(prefix,port_num)    prefix##port_num
+
+#define GPIO_PORT_0                    PORTA
+#define GPIO_PORT_1                    PORTB
+#define GPIO_PORT_2                    PORTC
+#define GPIO_PORT_3                    PORTD
+#define GPIO_DDR_0                     DDRA
+#define GPIO_DDR_1                     DDRB
+#define GPIO_DDR_2                     DDRC
+#define GPIO_DDR_3                     DDRD
+#define GPIO_PIN_0                     PINA
+#define GPIO_PIN_1                     PINB
+#define GPIO_PIN_2                     PINC
+#define GPIO_PIN_3                     PIND
+
+/* The host simulation builds define these in their <avr/io.h> to follow the static accesses */
+#ifndef GPIO_STATIC_WRITE_HOOK
+#define GPIO_STATIC_WRITE_HOOK()
+#endif
+#ifndef GPIO_STATIC_READ_HOOK
+#define GPIO_STATIC_READ_HOOK(port_num) ((void)0)
+#endif
+
+/* Static version of GPIO_setupPinDirection */
+#define GPIO_STATIC_SETUP_PIN_DIRECTION(port_num,pin_num,direction) \
+	do { \
+		if((direction) == PIN_OUTPUT) SET_BIT(GPIO_DDR_REG(port_num),(pin_num)); \
+		else CLEAR_BIT(GPIO_DDR_REG(port_num),(pin_num)); \
+		GPIO_STATIC_WRITE_HOOK(); \
+	} while(0)
+
+/* Static version of GPIO_writePin */
+#define GPIO_STATIC_WRITE_PIN(port_num,pin_num,value) \
+	do { \
+		if((value) == LOGIC_HIGH) SET_BIT(GPIO_PORT_REG(port_num),(pin_num)); \
+		else CLEAR_BIT(GPIO_PORT_REG(port_num),(pin_num)); \
+		GPIO_STATIC_WRITE_HOOK(); \
+	} while(0)
+
+/* Static version of GPIO_readPin */
+#define GPIO_STATIC_READ_PIN(port_num,pin_num) \
+	(GPIO_STATIC_READ_HOOK(port_num), \
+	 (BIT_IS_SET(GPIO_PIN_REG(port_num),(pin_num)) ? LOGIC_HIGH : LOGIC_LOW))
+
+/* Static version of GPIO_setupPortDirection */
+#define GPIO_STATIC_SETUP_PORT_DIRECTION(port_num,direction) \
+	do { \
+		GPIO_DDR_REG(port_num) = (direction); \
+		GPIO_STATIC_WRITE_HOOK(); \
+	} while(0)
+
+/* Static version of GPIO_writePort */
+#define GPIO_STATIC_WRITE_PORT(port_num,value) \
+	do { \
+		GPIO_PORT_REG(port_num) = (value); \
+		GPIO_STATIC_WRITE_HOOK(); \
+	} while(0)
+
+/* Static version of GPIO_readPort */
+#define GPIO_STATIC_READ_PORT(port_num) \
+	(GPIO_STATIC_READ_HOOK(port_num), GPIO_PIN_REG(port_num))
+
+/* Static version of GPIO_writePortMasked: IN, AND, OR, OUT with the interrupts disabled */
+#define GPIO_STATIC_WRITE_PORT_MASKED(port_num,mask,value) \
+	do { \
+		uint8 gpio_sreg = SREG; \
+		cli(); \
+		GPIO_PORT_REG(port_num) = (GPIO_PORT_REG(port_num) & ~(mask)) | ((value) & (mask)); \
+		SREG = gpio_sreg; \
+		GPIO_STATIC_WRITE_HOOK(); \
+	} while(0)
+
+/* Static version of GPIO_togglePins (the ATmega16 can not toggle by writing PINx) */
+#define GPIO_STATIC_TOGGLE_PINS(port_num,mask) \
+	do { \
+		uint8 gpio_sreg = SREG; \
+		cli(); \
+		GPIO_PORT_REG(port_num) ^= (mask); \
+		SREG = gpio_sreg; \
+		GPIO_STATIC_WRITE_HOOK(); \
+	} while(0)
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+	PIN_INPUT,PIN_OUTPUT
+}GPIO_PinDirectionType;
+
+typedef enum
+{
+	PORT_INPUT,PORT_OUTPUT=0xFF
+}GPIO_PortDirectionType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Setup the direction of the required pin input/output.
+ * If the input port number or pin number are not correct, The function will not handle the request.
+ */
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction);
+
+/*
+ * Description :
+ * Write the value Logic High or Logic Low on the required pin.
+ * If the input port number or pin number are not correct, The function will not handle the request.
+ * If the pin is input, this function will enable/disable the internal pull-up resistor.
+ */
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value);
+
+/*
+ * Description :
+ * Read and return the value for the required pin, it should be Logic High or Logic Low.
+ * If the input port number or pin number are not correct, The function will return Logic Low.
+ */
+uint8 GPIO_readPin(uint8 port_num, uint8 pin_num);
+
+/*
+ * Description :
+ * Setup the direction of the required port all pins input/output.
+ * If the direction value is PORT_INPUT all pins in this port should be input pins.
+ * If the direction value is PORT_OUTPUT all pins in this port should be output pins.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_setupPortDirection(uint8 port_num, uint8 direction);
+
+/*
+ * Description :
+ * Write the value on the required port.
+ * If any pin in the port is output pin the value will be written.
+ * If any pin in the port is input pin this will activate/deactivate the internal pull-up resistor.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePort(uint8 port_num, uint8 value);
+
+/*
+ * Description :
+ * Read and return the value of the required port.
+ * If the input port number is not correct, The function will return ZERO value.
+ */
+uint8 GPIO_readPort(uint8 port_num);
+
+/*
+ * Description :
+ * Write value on the pins of mask in the required port, the other pins keep their value.
+ * All the pins change at the same time (one write) and the read-modify-write runs with
+ * the interrupts disabled, so an ISR writing other pins of the port is not undone.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePortMasked(uint8 port_num, uint8 mask, uint8 value);
+
+/*
+ * Description :
+ * Toggle the pins of mask in the required port, in one interrupt safe read-modify-write.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_togglePins(uint8 port_num, uint8 mask);
+
+#endif /* GPIO_H_ */
@@ -1,101 +1,155 @@
-/******************************************************************************
- *
- * Module: Timer
- *
- * File Name: timer.h
- *
- * Description: Header file for the Timer AVR driver
- *
- * Author: Menna Saeed
- *
- *******************************************************************************/
-
-#ifndef TIMER_H_
-#define TIMER_H_
-
-#include "std_types.h"
-#include "common_macros.h"
-#include <avr\interrupt.h>
-#include "avr/io.h"
-/*-----------------------------------------------------------------------------
- *                         Types Declaration                                   *
--------------------------------------------------------------------------------*/
-typedef enum{
-	TIMER_0_ID,TIMER_1_ID,TIMER_2_ID
-}TIMER_ID;
-
-typedef enum{
-	NO_CLOCK,F_CPU_1,F_CPU_8,F_CPU_64,F_CPU_256,F_CPU_1024
-}TIMER_Prescaler;
-
-typedef enum{
-	NORMAL_MODE,COMPARE_MODE
-}TIMER_MODE;
-
-/*-------------------------------------------------------------------------------
- * [Structure Name]: TIMER_ConfigType
- *
- * [Description]: This structure is responsible for maintaining information about the Timer configuration
- ----------------------------------------------------------------------------------*/
-typedef struct
-{
-	/*
-	 * Timer_ID is a struct member of type TIMER_ID
-	 */
-			TIMER_ID 		Timer_ID;
-	/*
-	 * prescaler is a struct member of type TIMER_Prescaler that indicates the selected clock
-	 */
-			TIMER_Prescaler prescaler;
-	/*
-	 * Timer_mode is a struct member of type TIMER_MODE that indicates the Timer selected mode
-	 */
-			TIMER_MODE		Timer_mode;
-	/*
-	 * Start_value is a uint16 variable to initiate the Timer Control Register
-	 */
-			uint16			Start_value;
-	/*
-	 * Compare_value is a uint16 variable used to set the Output compare register value in case of Compare mode selected
-	 */
-			uint16	   	    Compare_value;
-}TIMER_ConfigType;
-
-/*-------------------------------------------------------------------------------
- *                       Functions Prototypes                           		 *
---------------------------------------------------------------------------------*/
-/*-------------------------------------------------------------------------------
- * [Function Name]: Timer_setCallBack
- *
- * [Description]:  Function to set the Call Back function address.
- *
- * [Args]:        a_ptr: a void pointer to a void function that takes the address of the call back function
- *				  Timer_ID: a variable of type TIMER_ID that switches the call back function according to the passed Timer ID
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Timer_setCallBack(void(*a_ptr)(void), TIMER_ID Timer_ID );
-/*-------------------------------------------------------------------------------
- * [Function Name]: Timer_init
- *
- * [Description]:  Function to initialize the Timer
- *
- * [Args]:        Config_Ptr: a constant pointer to struct that defines the Timer required configuration
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Timer_init (const TIMER_ConfigType * Config_Ptr);
-/*-------------------------------------------------------------------------------
- * [Function Name]: Timer_DeInit
- *
- * [Description]:  Function to quit the Timer
- *
- * [Args]:        Timer_ID: a variable of type TIMER_ID that switches the call back function according to the passed Timer ID
- *
- * [Returns]:      Void
- *
- ----------------------------------------------------------------------------------*/
-void Timer_DeInit(TIMER_ID Timer_ID);
-
-#endif /* TIMER_H_ */
+/******************************************************************************
+ *
+ * Module: Timer
+ *
+ * File Name: timer.h
+ *
+ * Description: Header file for the Timer AVR driver
+ *
+ * Author: Menna Saeed
+ *
+ *******************************************************************************/
+
+#ifndef TIMER_H_
+#define TIMER_H_
+
+#include "std_types.h"
+#include "common_macros.h"
+#include <avr/interrupt.h>
+#include "avr/io.h"
+/*-----------------------------------------------------------------------------
+ *                         Definitions                                         *
+-------------------------------------------------------------------------------*/
+/*
+ * System tick of both ECUs: Timer1 in COMPARE_MODE runs the Timer1 call back
+ * TICKS_PER_SECOND times per second, every time of the door, alarm and lockout
+ * is counted in these ticks
+ */
+#define TICKS_PER_SECOND				100
+#define TICK_TIMER_PRESCALER			F_CPU_64
+#define TICK_TIMER_PRESCALER_DIVISOR	64UL
+#define TICK_TIMER_COMPARE_VALUE		((F_CPU / (TICK_TIMER_PRESCALER_DIVISOR * TICKS_PER_SECOND)) - 1)
+
+#if ((F_CPU % (TICK_TIMER_PRESCALER_DIVISOR * TICKS_PER_SECOND)) != 0) || (TICK_TIMER_COMPARE_VALUE > 0xFFFF)
+#error "Timer1 can not divide F_CPU down to TICKS_PER_SECOND, change the tick prescaler"
+#endif
+
+#define SECONDS_TO_TICKS(s)				((uint32)(s) * TICKS_PER_SECOND)
+#define MS_TO_TICKS(ms)					(((uint32)(ms) * TICKS_PER_SECOND + 999) / 1000)
+
+/*-----------------------------------------------------------------------------
+ *                         Types Declaration                                   *
+-------------------------------------------------------------------------------*/
+typedef enum{
+	TIMER_0_ID,TIMER_1_ID,TIMER_2_ID
+}TIMER_ID;
+
+typedef enum{
+	NO_CLOCK,F_CPU_1,F_CPU_8,F_CPU_64,F_CPU_256,F_CPU_1024
+}TIMER_Prescaler;
+
+/*
+ * FAST_PWM_MODE (Timer0 and Timer2 only): non-inverting PWM on the OC0/OC2 pin with
+ * Compare_value as the duty (0-255), the call back function runs at every overflow
+ * (once per PWM period). The pin direction is set by the driver using it.
+ *
+ * COMPARE_TOGGLE_MODE (Timer0 and Timer2 only): COMPARE_MODE that also toggles the OC0/OC2
+ * pin at every compare match, a square wave of F_CPU / (2 * prescaler * (1 + Compare_value)).
+ * The call back function runs at every compare match, Timer_setCompareOutput disconnects
+ * the pin (silence) without stopping the timer.
+ */
+typedef enum{
+	NORMAL_MODE,COMPARE_MODE,FAST_PWM_MODE,COMPARE_TOGGLE_MODE
+}TIMER_MODE;
+
+/*-------------------------------------------------------------------------------
+ * [Structure Name]: TIMER_ConfigType
+ *
+ * [Description]: This structure is responsible for maintaining information about the Timer configuration
+ ----------------------------------------------------------------------------------*/
+typedef struct
+{
+	/*
+	 * Timer_ID is a struct member of type TIMER_ID
+	 */
+			TIMER_ID 		Timer_ID;
+	/*
+	 * prescaler is a struct member of type TIMER_Prescaler that indicates the selected clock
+	 */
+			TIMER_Prescaler prescaler;
+	/*
+	 * Timer_mode is a struct member of type TIMER_MODE that indicates the Timer selected mode
+	 */
+			TIMER_MODE		Timer_mode;
+	/*
+	 * Start_value is a uint16 variable to initiate the Timer Control Register
+	 */
+			uint16			Start_value;
+	/*
+	 * Compare_value is a uint16 variable used to set the Output compare register value in case of Compare mode selected
+	 */
+			uint16	   	    Compare_value;
+}TIMER_ConfigType;
+
+/*-------------------------------------------------------------------------------
+ *                       Functions Prototypes                           		 *
+--------------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Timer_setCallBack
+ *
+ * [Description]:  Function to set the Call Back function address.
+ *
+ * [Args]:        a_ptr: a void pointer to a void function that takes the address of the call back function
+ *				  Timer_ID: a variable of type TIMER_ID that switches the call back function according to the passed Timer ID
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Timer_setCallBack(void(*a_ptr)(void), TIMER_ID Timer_ID );
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Timer_init
+ *
+ * [Description]:  Function to initialize the Timer
+ *
+ * [Args]:        Config_Ptr: a constant pointer to struct that defines the Timer required configuration
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Timer_init (const TIMER_ConfigType * Config_Ptr);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Timer_DeInit
+ *
+ * [Description]:  Function to quit the Timer
+ *
+ * [Args]:        Timer_ID: a variable of type TIMER_ID that switches the call back function according to the passed Timer ID
+ *
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Timer_DeInit(TIMER_ID Timer_ID);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Timer_setCompareValue
+ *
+ * [Description]:  Function to change the Output compare register of a running Timer
+ * 					(the duty cycle in FAST_PWM_MODE)
+ *
+ * [Args]:        Compare_value: the new Output compare register value
+ *				  Timer_ID: a variable of type TIMER_ID that selects the Timer
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Timer_setCompareValue(uint16 Compare_value, TIMER_ID Timer_ID);
+/*-------------------------------------------------------------------------------
+ * [Function Name]: Timer_setCompareOutput
+ *
+ * [Description]:  Function to connect or disconnect the OC0/OC2 pin of a Timer in
+ * 					COMPARE_TOGGLE_MODE, a disconnected pin takes its PORT value
+ *
+ * [Args]:        enable: TRUE to toggle the pin at every compare match, FALSE to disconnect it
+ *				  Timer_ID: TIMER_0_ID or TIMER_2_ID
+ * [Returns]:      Void
+ *
+ ----------------------------------------------------------------------------------*/
+void Timer_setCompareOutput(boolean enable, TIMER_ID Timer_ID);
+
+#endif /* TIMER_H_ */
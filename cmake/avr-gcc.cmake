@@ -0,0 +1,22 @@
+# Toolchain file of the ECU firmware: avr-gcc for the ATmega16 of both ECUs
+#   cmake -S . -B build-avr -DCMAKE_TOOLCHAIN_FILE=cmake/avr-gcc.cmake
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR avr)
+
+set(AVR_MCU atmega16)
+set(AVR_FLASH_SIZE 16384)
+set(AVR_RAM_SIZE 1024)
+
+set(CMAKE_C_COMPILER avr-gcc)
+
+# avr-gcc does not link a program without a device, the compiler checks build a library
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+# -g only feeds the per-module map (nm --line-numbers), nothing of it is flashed
+set(CMAKE_C_FLAGS_INIT "-mmcu=${AVR_MCU} -g -funsigned-char -funsigned-bitfields -fpack-struct -fshort-enums -ffunction-sections -fdata-sections")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "-mmcu=${AVR_MCU} -Wl,--gc-sections")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
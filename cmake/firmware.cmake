@@ -0,0 +1,32 @@
+# Firmware outputs of an ECU: the Intel hex images, the size summary after every link
+# and the <target>_map target (part of the map target) with the flash/RAM of every module.
+
+find_program(AVR_SIZE avr-size REQUIRED)
+find_program(AVR_NM avr-nm REQUIRED)
+find_program(AVR_READELF avr-readelf REQUIRED)
+
+set(DOOR_LOCKER_MAP_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/module_map.cmake)
+
+function(door_locker_add_firmware target)
+	set_target_properties(${target} PROPERTIES SUFFIX ".elf")
+	target_link_options(${target} PRIVATE "-Wl,-Map=$<TARGET_FILE_DIR:${target}>/${target}.map")
+
+	add_custom_command(TARGET ${target} POST_BUILD
+		COMMAND ${CMAKE_OBJCOPY} -O ihex -R .eeprom $<TARGET_FILE:${target}> ${target}.hex
+		COMMAND ${CMAKE_OBJCOPY} -O ihex -j .eeprom --set-section-flags=.eeprom=alloc,load
+				--change-section-lma .eeprom=0 --no-change-warnings $<TARGET_FILE:${target}> ${target}_eeprom.hex
+		COMMAND ${AVR_SIZE} --format=avr --mcu=${AVR_MCU} $<TARGET_FILE:${target}>
+		WORKING_DIRECTORY $<TARGET_FILE_DIR:${target}>
+		VERBATIM)
+
+	add_custom_target(${target}_map
+		COMMAND ${CMAKE_COMMAND}
+				-DNM=${AVR_NM} -DREADELF=${AVR_READELF} -DSIZE=${AVR_SIZE} -DELF=$<TARGET_FILE:${target}>
+				"-DOBJECTS=$<JOIN:$<TARGET_OBJECTS:${target}>;$<TARGET_OBJECTS:shared_drivers>,|>"
+				-DSOURCE_DIR=${PROJECT_SOURCE_DIR}
+				-DFLASH_SIZE=${AVR_FLASH_SIZE} -DRAM_SIZE=${AVR_RAM_SIZE}
+				-P ${DOOR_LOCKER_MAP_SCRIPT}
+		DEPENDS ${target}
+		VERBATIM)
+	add_dependencies(map ${target}_map)
+endfunction()
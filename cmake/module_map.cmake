@@ -0,0 +1,150 @@
+# Flash/RAM map per module of a firmware image
+#   cmake -DNM=avr-nm -DREADELF=avr-readelf -DSIZE=avr-size -DELF=<elf> -DOBJECTS=<a.obj|b.obj|...>
+#         -DSOURCE_DIR=<dir> -DFLASH_SIZE=<n> -DRAM_SIZE=<n> -P module_map.cmake
+#
+# Every symbol of the linked image is charged to the source file of its definition
+# (nm --line-numbers, from the debug info), so the map is right after --gc-sections and LTO
+# as well. After LTO the debug info has no source file for the variables, those are
+# looked up by name in the objects of the modules. Code and flash tables count as flash,
+# initialized data as flash and RAM, zeroed data as RAM. The symbols of no module
+# (C runtime, libgcc, avr-libc) are summed as runtime, the totals are the ones of the
+# ELF sections.
+
+cmake_minimum_required(VERSION 3.13)
+
+# Split the output of a tool into a list of lines
+macro(split_lines var)
+	string(REPLACE ";" "\\;" ${var} "${${var}}")
+	string(REPLACE "\n" ";" ${var} "${${var}}")
+endmacro()
+
+# name -> module of the symbols defined by the objects, a name defined by two modules
+# (static variables) is charged to runtime
+file(GLOB_RECURSE sources RELATIVE ${SOURCE_DIR} ${SOURCE_DIR}/*.c)
+string(REPLACE "|" ";" objects "${OBJECTS}")
+foreach(object IN LISTS objects)
+	# CMakeFiles/<target>.dir/<source path in the target directory>.obj
+	string(REGEX REPLACE "^.*\\.dir/(.*)\\.(obj|o)$" "\\1" source "${object}")
+	set(object_module "")
+	foreach(candidate IN LISTS sources)
+		if("/${candidate}" MATCHES "/${source}$")
+			set(object_module "${candidate}")
+			break()
+		endif()
+	endforeach()
+	if(object_module STREQUAL "")
+		continue()
+	endif()
+
+	# readelf reads the machine code symbols of the fat LTO objects, nm would read the
+	# LTO symbol table without the statics
+	execute_process(COMMAND ${READELF} --syms --wide ${object} OUTPUT_VARIABLE object_symbols)
+	split_lines(object_symbols)
+	foreach(line IN LISTS object_symbols)
+		if(line MATCHES "^ *[0-9]+: [0-9a-fA-F]+ +[0-9]+ (OBJECT|FUNC) +[A-Z]+ +[A-Z]+ +[0-9]+ ([A-Za-z_][A-Za-z0-9_]*)")
+			set(name ${CMAKE_MATCH_2})
+			if(DEFINED owner_${name} AND NOT owner_${name} STREQUAL object_module)
+				set(owner_${name} "(runtime)")
+			else()
+				set(owner_${name} "${object_module}")
+			endif()
+		endif()
+	endforeach()
+endforeach()
+
+execute_process(COMMAND ${NM} --print-size --line-numbers --defined-only ${ELF}
+	OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "${NM} failed on ${ELF}")
+endif()
+split_lines(symbols)
+
+set(modules "")
+foreach(line IN LISTS symbols)
+	if(NOT line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) ([A-Za-z]) ([^\t]+)(\t(.+):[0-9]+)?$")
+		continue()
+	endif()
+	math(EXPR size "0x${CMAKE_MATCH_1}")
+	set(type ${CMAKE_MATCH_2})
+	set(name "${CMAKE_MATCH_3}")
+	set(file "${CMAKE_MATCH_5}")
+
+	# the LTO copies of the statics are renamed name.lto_priv.0, name.constprop.0 ...
+	string(REGEX REPLACE "\\..*$" "" name "${name}")
+	if(file)
+		file(RELATIVE_PATH module ${SOURCE_DIR} ${file})
+	elseif(DEFINED owner_${name})
+		set(module "${owner_${name}}")
+	else()
+		set(module "(runtime)")
+	endif()
+	string(MAKE_C_IDENTIFIER "${module}" key)
+
+	if(type MATCHES "[TtRr]")
+		set(flash_size ${size})
+		set(ram_size 0)
+	elseif(type MATCHES "[DdGg]")
+		set(flash_size ${size})
+		set(ram_size ${size})
+	elseif(type MATCHES "[BbSs]")
+		set(flash_size 0)
+		set(ram_size ${size})
+	else()
+		continue()
+	endif()
+
+	if(NOT "${module}" IN_LIST modules)
+		list(APPEND modules "${module}")
+		set(flash_${key} 0)
+		set(ram_${key} 0)
+	endif()
+	math(EXPR flash_${key} "${flash_${key}} + ${flash_size}")
+	math(EXPR ram_${key} "${ram_${key}} + ${ram_size}")
+endforeach()
+
+function(pad_left out text width)
+	string(LENGTH "${text}" length)
+	while(length LESS width)
+		string(PREPEND text " ")
+		math(EXPR length "${length} + 1")
+	endwhile()
+	set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+function(pad_right out text width)
+	string(LENGTH "${text}" length)
+	while(length LESS width)
+		string(APPEND text " ")
+		math(EXPR length "${length} + 1")
+	endwhile()
+	set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+function(print_row name flash ram)
+	pad_right(name "${name}" 60)
+	pad_left(flash "${flash}" 8)
+	pad_left(ram "${ram}" 8)
+	message("${name}${flash}${ram}")
+endfunction()
+
+get_filename_component(image ${ELF} NAME)
+message("")
+message("${image}: flash/RAM bytes per module")
+print_row("Module" "Flash" "RAM")
+list(SORT modules)
+foreach(module IN LISTS modules)
+	string(MAKE_C_IDENTIFIER "${module}" key)
+	print_row("${module}" "${flash_${key}}" "${ram_${key}}")
+endforeach()
+
+# Berkeley format: text data bss dec hex filename
+execute_process(COMMAND ${SIZE} --format=berkeley ${ELF} OUTPUT_VARIABLE sizes RESULT_VARIABLE result)
+if(NOT result EQUAL 0 OR NOT sizes MATCHES "\n[ \t]*([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)")
+	message(FATAL_ERROR "${SIZE} failed on ${ELF}")
+endif()
+math(EXPR flash "${CMAKE_MATCH_1} + ${CMAKE_MATCH_2}")
+math(EXPR ram "${CMAKE_MATCH_2} + ${CMAKE_MATCH_3}")
+print_row("Total (stack not included)" "${flash}" "${ram}")
+if(FLASH_SIZE AND RAM_SIZE)
+	print_row("Device" "${FLASH_SIZE}" "${RAM_SIZE}")
+endif()